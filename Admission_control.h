@@ -0,0 +1,269 @@
+#ifndef ADMISSION_CONTROL_H
+#define ADMISSION_CONTROL_H
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "Scheduling_engine.h"
+#include "Schedulability_analysis.h"
+#include "Message_framing.h"
+#include "Sensitivity_analysis.h"
+
+// Online admission control for a resident task set and signal framing.
+//
+// The state lives in immutable snapshots: a query reads the current snapshot
+// through an atomic shared_ptr load and never waits on the writer mutex, and a
+// change builds a new snapshot under the writer lock and publishes it with an
+// atomic store. (libstdc++ implements those atomic operations with a small
+// internal lock, held only for the pointer copy.) Every snapshot keeps the
+// partition and response times of each processor, so admitting a task only
+// re-runs RTA from its priority level on, warm-started from the cached
+// response times: adding a task can only delay the tasks below it, so those
+// are valid lower bounds. That holds only for a processor whose current tasks
+// all meet their deadlines, so a snapshot runs the full RTA of every
+// processor when it is built and no task is placed on one that fails it.
+
+struct AdmissionSnapshot {
+    unsigned version;
+    int num_processors;
+    std::vector<PeriodicTask> tasks;
+    std::vector<std::vector<TaskTiming>> partitions; // Per processor, in priority order
+    std::vector<std::vector<float>> ranks; // Rank of each partition entry
+    std::vector<std::vector<double>> response_time; // RTA of each partition entry
+    std::vector<double> utilization; // Per processor
+    std::vector<char> feasible; // Per processor: every task meets its deadline
+    std::vector<Signal> signals;
+    int Tc; // Cycle length of the signals, 0 without signals
+    int slot_size; // Optimal slot size of the framing, 0 without signals
+};
+
+// Where a task would go and how it would fare
+struct TaskPlacement {
+    bool admitted;
+    int processor;
+    int position; // Index in the processor's priority order
+    double response_time;
+    double utilization; // Of the processor after admission
+    std::vector<TaskTiming> partition; // Processor's tasks with the new one inserted
+    std::vector<double> response; // And their response times
+};
+
+struct SignalPlacement {
+    bool admitted;
+    int Tc;
+    int slot_size;
+};
+
+// Build a snapshot from a task set already placed by
+// SchedulingEngine::schedulePeriodicTasks() and a signal set
+template <class RankPolicy = PeriodRank>
+std::shared_ptr<const AdmissionSnapshot> makeSnapshot(const std::vector<PeriodicTask>& tasks, int num_processors,
+                                                      const std::vector<Signal>& signals, unsigned version) {
+    std::shared_ptr<AdmissionSnapshot> snapshot = std::make_shared<AdmissionSnapshot>();
+    snapshot->version = version;
+    snapshot->num_processors = num_processors;
+    snapshot->tasks = tasks;
+    for (auto& task : snapshot->tasks)
+        task.rank = RankPolicy::rank(task);
+    snapshot->partitions = partitionByProcessor(snapshot->tasks, num_processors);
+    snapshot->ranks.resize(num_processors);
+    snapshot->response_time.resize(num_processors);
+    snapshot->utilization.resize(num_processors);
+    snapshot->feasible.resize(num_processors);
+    std::vector<const PeriodicTask*> ordered;
+    for (const auto& task : snapshot->tasks)
+        ordered.push_back(&task);
+    std::stable_sort(ordered.begin(), ordered.end(), [](const PeriodicTask* a, const PeriodicTask* b) {
+        return a->rank < b->rank;
+    });
+    for (const PeriodicTask* task : ordered)
+        snapshot->ranks[task->processor].push_back(task->rank);
+    for (int p = 0; p < num_processors; ++p) {
+        snapshot->feasible[p] = responseTimeAnalysis(snapshot->partitions[p], &snapshot->response_time[p]);
+        snapshot->utilization[p] = utilization(snapshot->partitions[p]);
+    }
+    snapshot->signals = signals;
+    snapshot->Tc = signals.empty() ? 0 : totalCycleLength(signals);
+    snapshot->slot_size = signals.empty() ? 0 : findOptimalSlotSize(signals, snapshot->Tc, maxAggregateSlotSize(signals, snapshot->Tc));
+    return snapshot;
+}
+
+// Least utilized feasible processor on which the task and every task below it
+// still meet their deadlines; the snapshot is not changed
+template <class RankPolicy = PeriodRank>
+TaskPlacement placeTask(const AdmissionSnapshot& snapshot, const PeriodicTask& task) {
+    TaskPlacement best{false, -1, -1, 0, std::numeric_limits<double>::infinity(), {}, {}};
+    const float rank = RankPolicy::rank(task);
+    for (int p = 0; p < snapshot.num_processors; ++p) {
+        const double wcet = task.processing_time[p];
+        const double u = snapshot.utilization[p] + wcet / task.period;
+        if (!snapshot.feasible[p] || u > 1.0 || u >= best.utilization || wcet > task.deadline)
+            continue;
+
+        const std::vector<float>& ranks = snapshot.ranks[p];
+        const int position = static_cast<int>(std::upper_bound(ranks.begin(), ranks.end(), rank) - ranks.begin());
+        std::vector<TaskTiming> partition = snapshot.partitions[p];
+        partition.insert(partition.begin() + position, {task.id, wcet, task.period, task.deadline});
+        std::vector<double> response = snapshot.response_time[p];
+        response.insert(response.begin() + position, 0.0);
+        if (!incrementalResponseTimeAnalysis(partition, position, response))
+            continue;
+
+        best.admitted = true;
+        best.processor = p;
+        best.position = position;
+        best.response_time = response[position];
+        best.utilization = u;
+        best.partition.swap(partition);
+        best.response.swap(response);
+    }
+    if (!best.admitted)
+        best.utilization = 0;
+    return best;
+}
+
+// Whether the signal fits the framing of the snapshot's signals
+inline SignalPlacement placeSignal(const AdmissionSnapshot& snapshot, const Signal& signal) {
+    std::vector<Signal> signals = snapshot.signals;
+    signals.push_back(signal);
+    int Tc = snapshot.Tc > 0 ? gcd(snapshot.Tc, signal.period) : signal.period;
+    if (Tc <= 0 || !framingFits(signals, Tc))
+        return {false, Tc, 0};
+    return {true, Tc, findOptimalSlotSize(signals, Tc, maxAggregateSlotSize(signals, Tc))};
+}
+
+// Current snapshot plus the serialized writers that replace it
+template <class Scheduler, class RankPolicy = PeriodRank>
+class AdmissionController {
+public:
+    AdmissionController(std::vector<PeriodicTask> tasks, int num_processors, const std::vector<Signal>& signals) {
+        if (num_processors < 1)
+            throw std::invalid_argument("AdmissionController needs at least one processor");
+        Scheduler::schedulePeriodicTasks(tasks, num_processors, false);
+        current_ = makeSnapshot<RankPolicy>(tasks, num_processors, signals, 1);
+    }
+
+    std::shared_ptr<const AdmissionSnapshot> snapshot() const { return std::atomic_load(&current_); }
+
+    // Where addTask() would place the task, with the same rank policy
+    TaskPlacement query(const AdmissionSnapshot& snapshot, const PeriodicTask& task) const {
+        return placeTask<RankPolicy>(snapshot, task);
+    }
+    TaskPlacement query(const PeriodicTask& task) const { return query(*snapshot(), task); }
+
+    // Admit and commit a task; the placement is checked against the latest snapshot
+    TaskPlacement addTask(PeriodicTask task) {
+        std::lock_guard<std::mutex> lock(writer_);
+        std::shared_ptr<const AdmissionSnapshot> base = snapshot();
+        if (findTask(*base, task.id) >= 0)
+            return TaskPlacement{false, -1, -1, 0, 0, {}, {}};
+        TaskPlacement placement = placeTask<RankPolicy>(*base, task);
+        if (!placement.admitted)
+            return placement;
+
+        std::shared_ptr<AdmissionSnapshot> next = std::make_shared<AdmissionSnapshot>(*base);
+        const int p = placement.processor;
+        task.rank = RankPolicy::rank(task);
+        task.processor = p;
+        next->tasks.push_back(task);
+        next->partitions[p] = placement.partition;
+        next->response_time[p] = placement.response;
+        next->ranks[p].insert(next->ranks[p].begin() + placement.position, task.rank);
+        next->utilization[p] = placement.utilization;
+        publish(next);
+        return placement;
+    }
+
+    // Remove a task; the processor is re-analysed from a cold start, which
+    // may make a processor that missed deadlines feasible again
+    bool removeTask(int id) {
+        std::lock_guard<std::mutex> lock(writer_);
+        std::shared_ptr<const AdmissionSnapshot> base = snapshot();
+        int index = findTask(*base, id);
+        if (index < 0)
+            return false;
+        std::shared_ptr<AdmissionSnapshot> next = std::make_shared<AdmissionSnapshot>(*base);
+        const int p = next->tasks[index].processor;
+        next->tasks.erase(next->tasks.begin() + index);
+        std::vector<TaskTiming>& partition = next->partitions[p];
+        for (std::size_t i = 0; i < partition.size(); ++i) {
+            if (partition[i].id != id)
+                continue;
+            partition.erase(partition.begin() + i);
+            next->ranks[p].erase(next->ranks[p].begin() + i);
+            break;
+        }
+        next->feasible[p] = responseTimeAnalysis(partition, &next->response_time[p]);
+        next->utilization[p] = utilization(partition);
+        publish(next);
+        return true;
+    }
+
+    SignalPlacement addSignal(const Signal& signal) {
+        std::lock_guard<std::mutex> lock(writer_);
+        std::shared_ptr<const AdmissionSnapshot> base = snapshot();
+        for (const Signal& existing : base->signals)
+            if (existing.id == signal.id)
+                return {false, base->Tc, base->slot_size};
+        SignalPlacement placement = placeSignal(*base, signal);
+        if (!placement.admitted)
+            return placement;
+        std::shared_ptr<AdmissionSnapshot> next = std::make_shared<AdmissionSnapshot>(*base);
+        next->signals.push_back(signal);
+        next->Tc = placement.Tc;
+        next->slot_size = placement.slot_size;
+        publish(next);
+        return placement;
+    }
+
+    bool removeSignal(int id) {
+        std::lock_guard<std::mutex> lock(writer_);
+        std::shared_ptr<const AdmissionSnapshot> base = snapshot();
+        std::vector<Signal> signals;
+        for (const Signal& signal : base->signals)
+            if (signal.id != id)
+                signals.push_back(signal);
+        if (signals.size() == base->signals.size())
+            return false;
+        std::shared_ptr<AdmissionSnapshot> next = std::make_shared<AdmissionSnapshot>(*base);
+        next->signals.swap(signals);
+        next->Tc = next->signals.empty() ? 0 : totalCycleLength(next->signals);
+        next->slot_size = next->signals.empty() ? 0 : findOptimalSlotSize(next->signals, next->Tc, maxAggregateSlotSize(next->signals, next->Tc));
+        publish(next);
+        return true;
+    }
+
+    // Place the whole task set again with the scheduler's policies
+    std::shared_ptr<const AdmissionSnapshot> reschedule() {
+        std::lock_guard<std::mutex> lock(writer_);
+        std::shared_ptr<const AdmissionSnapshot> base = snapshot();
+        std::vector<PeriodicTask> tasks = base->tasks;
+        Scheduler::schedulePeriodicTasks(tasks, base->num_processors, false);
+        std::shared_ptr<const AdmissionSnapshot> next = makeSnapshot<RankPolicy>(tasks, base->num_processors, base->signals, base->version + 1);
+        std::atomic_store(&current_, next);
+        return next;
+    }
+
+private:
+    static int findTask(const AdmissionSnapshot& snapshot, int id) {
+        for (std::size_t i = 0; i < snapshot.tasks.size(); ++i)
+            if (snapshot.tasks[i].id == id)
+                return static_cast<int>(i);
+        return -1;
+    }
+
+    void publish(std::shared_ptr<AdmissionSnapshot> next) {
+        ++next->version;
+        std::atomic_store(&current_, std::shared_ptr<const AdmissionSnapshot>(std::move(next)));
+    }
+
+    std::shared_ptr<const AdmissionSnapshot> current_;
+    std::mutex writer_;
+};
+
+#endif // ADMISSION_CONTROL_H
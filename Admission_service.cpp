@@ -0,0 +1,354 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Scheduling_engine.h"
+#include "Message_framing.h"
+#include "Admission_control.h"
+
+using namespace std;
+
+// Resident admission-control service on a UNIX domain socket.
+//
+// The task set, its schedule and the signal framing stay in memory and are
+// queried over SOCK_SEQPACKET, one request per packet, in host byte order:
+//   request  u8 op | u8 count | u16 reserved | u32 tag | i32 id | count x f32 values
+//   response u8 status | u8 reserved | i16 processor | u32 tag | u32 version | f32 value | f32 utilization
+// Values per op:
+//   QueryTask / AddTask     period, deadline, processing time on each processor
+//   QuerySignal / AddSignal size, period
+//   RemoveTask / RemoveSignal, Reschedule, Status: none
+// value is the task's response time or the framing slot size; for Status it
+// is the number of tasks, with the number of signals in processor. A task
+// needs a finite positive period, a deadline no longer than the period and
+// finite positive processing times. A signal's size is a whole number of
+// bytes up to the FlexRay payload of 254, and its period a whole number of
+// ticks up to MAX_SIGNAL_PERIOD; anything else is a BadRequest. Framing a
+// signal costs O(Tc * n) for cycle length Tc <= period and n signals, so
+// those bounds and the MAX_SIGNALS limit (Reject beyond it) keep one request
+// from holding the writer for long. Queries are answered from the current
+// snapshot without waiting on the writer lock; each connection is served by
+// its own thread, which shares ownership of the controller.
+//
+// Usage: Admission_service serve <socket_path>
+//        Admission_service bench <socket_path> [requests] [clients]
+
+using Scheduler = SchedulingEngine<PeriodRank, EarliestAvailableProcessor, EarliestFinishBus, SourceEftEst>;
+using Controller = AdmissionController<Scheduler>;
+
+enum Op : uint8_t { QueryTask = 1, AddTask, RemoveTask, QuerySignal, AddSignal, RemoveSignal, Reschedule, Status };
+enum Result : uint8_t { Admit = 0, Reject = 1, BadRequest = 2, UnknownId = 3 };
+
+const size_t REQUEST_HEADER = 12;
+const size_t RESPONSE_SIZE = 20;
+const size_t MAX_VALUES = 64;
+const int MAX_SIGNAL_SIZE = 254; // FlexRay payload bytes
+const int MAX_SIGNAL_PERIOD = 10000; // Ticks
+const size_t MAX_SIGNALS = 4096;
+
+struct Request {
+    uint8_t op;
+    uint8_t count;
+    uint32_t tag;
+    int32_t id;
+    float values[MAX_VALUES];
+};
+
+struct Response {
+    uint8_t status;
+    int16_t processor;
+    uint32_t tag;
+    uint32_t version;
+    float value;
+    float utilization;
+};
+
+size_t encodeRequest(const Request& request, char* buffer) {
+    buffer[0] = static_cast<char>(request.op);
+    buffer[1] = static_cast<char>(request.count);
+    buffer[2] = buffer[3] = 0;
+    memcpy(buffer + 4, &request.tag, 4);
+    memcpy(buffer + 8, &request.id, 4);
+    memcpy(buffer + REQUEST_HEADER, request.values, request.count * sizeof(float));
+    return REQUEST_HEADER + request.count * sizeof(float);
+}
+
+bool decodeRequest(const char* buffer, size_t size, Request& request) {
+    if (size < REQUEST_HEADER)
+        return false;
+    request.op = static_cast<uint8_t>(buffer[0]);
+    request.count = static_cast<uint8_t>(buffer[1]);
+    memcpy(&request.tag, buffer + 4, 4);
+    memcpy(&request.id, buffer + 8, 4);
+    if (request.count > MAX_VALUES || size != REQUEST_HEADER + request.count * sizeof(float))
+        return false;
+    memcpy(request.values, buffer + REQUEST_HEADER, request.count * sizeof(float));
+    return true;
+}
+
+void encodeResponse(const Response& response, char* buffer) {
+    buffer[0] = static_cast<char>(response.status);
+    buffer[1] = 0;
+    memcpy(buffer + 2, &response.processor, 2);
+    memcpy(buffer + 4, &response.tag, 4);
+    memcpy(buffer + 8, &response.version, 4);
+    memcpy(buffer + 12, &response.value, 4);
+    memcpy(buffer + 16, &response.utilization, 4);
+}
+
+Response decodeResponse(const char* buffer) {
+    Response response;
+    response.status = static_cast<uint8_t>(buffer[0]);
+    memcpy(&response.processor, buffer + 2, 2);
+    memcpy(&response.tag, buffer + 4, 4);
+    memcpy(&response.version, buffer + 8, 4);
+    memcpy(&response.value, buffer + 12, 4);
+    memcpy(&response.utilization, buffer + 16, 4);
+    return response;
+}
+
+// Period, deadline and one processing time per processor
+bool validTask(const Request& request, int num_processors) {
+    if (request.count != 2 + num_processors)
+        return false;
+    const float period = request.values[0];
+    const float deadline = request.values[1];
+    if (!isfinite(period) || !(period > 0) || !isfinite(deadline) || !(deadline > 0) || deadline > period)
+        return false;
+    for (int p = 0; p < num_processors; ++p)
+        if (!isfinite(request.values[2 + p]) || !(request.values[2 + p] > 0))
+            return false;
+    return true;
+}
+
+// Size and period, both converted to int
+bool validSignal(const Request& request) {
+    if (request.count != 2)
+        return false;
+    const float limits[2] = {static_cast<float>(MAX_SIGNAL_SIZE), static_cast<float>(MAX_SIGNAL_PERIOD)};
+    for (int v = 0; v < 2; ++v) {
+        const float value = request.values[v];
+        if (!(value >= 1 && value <= limits[v]) || floor(value) != value)
+            return false;
+    }
+    return true;
+}
+
+Response handle(Controller& controller, const Request& request) {
+    Response response{BadRequest, -1, request.tag, 0, 0, 0};
+    shared_ptr<const AdmissionSnapshot> snapshot = controller.snapshot();
+    const int num_processors = snapshot->num_processors;
+    response.version = snapshot->version;
+
+    switch (request.op) {
+    case QueryTask:
+    case AddTask: {
+        if (!validTask(request, num_processors))
+            break;
+        PeriodicTask task{request.id, request.values[0], request.values[1],
+                          vector<float>(request.values + 2, request.values + 2 + num_processors), 0, 0, 0, 0, -1};
+        TaskPlacement placement = request.op == QueryTask ? controller.query(*snapshot, task) : controller.addTask(task);
+        response.status = placement.admitted ? Admit : Reject;
+        response.processor = static_cast<int16_t>(placement.processor);
+        response.value = static_cast<float>(placement.response_time);
+        response.utilization = static_cast<float>(placement.utilization);
+        break;
+    }
+    case QuerySignal:
+    case AddSignal: {
+        if (!validSignal(request))
+            break;
+        if (snapshot->signals.size() >= MAX_SIGNALS) {
+            response.status = Reject;
+            break;
+        }
+        Signal signal(request.id, static_cast<int>(request.values[0]), static_cast<int>(request.values[1]));
+        SignalPlacement placement = request.op == QuerySignal ? placeSignal(*snapshot, signal) : controller.addSignal(signal);
+        response.status = placement.admitted ? Admit : Reject;
+        response.value = static_cast<float>(placement.slot_size);
+        break;
+    }
+    case RemoveTask:
+        response.status = controller.removeTask(request.id) ? Admit : UnknownId;
+        break;
+    case RemoveSignal:
+        response.status = controller.removeSignal(request.id) ? Admit : UnknownId;
+        break;
+    case Reschedule:
+        snapshot = controller.reschedule();
+        response.status = Admit;
+        break;
+    case Status:
+        response.status = Admit;
+        response.value = static_cast<float>(snapshot->tasks.size());
+        response.processor = static_cast<int16_t>(snapshot->signals.size());
+        if (!snapshot->utilization.empty())
+            response.utilization = static_cast<float>(*max_element(snapshot->utilization.begin(), snapshot->utilization.end()));
+        break;
+    }
+    if (request.op != QueryTask && request.op != QuerySignal)
+        response.version = controller.snapshot()->version;
+    return response;
+}
+
+void serveConnection(shared_ptr<Controller> controller, int fd) {
+    char buffer[REQUEST_HEADER + MAX_VALUES * sizeof(float) + 1];
+    char reply[RESPONSE_SIZE];
+    Request request;
+    while (true) {
+        ssize_t size = recv(fd, buffer, sizeof(buffer), 0);
+        if (size <= 0)
+            break;
+        Response response;
+        if (decodeRequest(buffer, static_cast<size_t>(size), request)) {
+            response = handle(*controller, request);
+        } else {
+            uint32_t tag = 0;
+            if (size >= 8)
+                memcpy(&tag, buffer + 4, 4);
+            response = Response{BadRequest, -1, tag, controller->snapshot()->version, 0, 0};
+        }
+        encodeResponse(response, reply);
+        if (send(fd, reply, sizeof(reply), MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(reply)))
+            break;
+    }
+    close(fd);
+}
+
+int openSocket(const string& path, bool listening) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        cerr << "Socket path too long: " << path << "\n";
+        return -1;
+    }
+    strcpy(address.sun_path, path.c_str());
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (fd < 0)
+        return -1;
+    if (listening) {
+        unlink(path.c_str());
+        if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(fd, 64) < 0) {
+            close(fd);
+            return -1;
+        }
+    } else if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int serve(const string& path) {
+    // Start from the example task set and signals of the standalone tools
+    vector<PeriodicTask> tasks = {
+        {1, 5, 5, {2, 3}, 0},
+        {2, 7, 7, {3, 4}, 0},
+    };
+    vector<Signal> signals = {
+        Signal(1, 2, 10), Signal(2, 3, 5), Signal(3, 1, 20),
+        Signal(4, 2, 10), Signal(5, 3, 5), Signal(6, 1, 20),
+    };
+    shared_ptr<Controller> controller = make_shared<Controller>(tasks, 2, signals);
+
+    int listener = openSocket(path, true);
+    if (listener < 0) {
+        cerr << "Cannot listen on " << path << ": " << strerror(errno) << "\n";
+        return 1;
+    }
+    cout << "Admission service listening on " << path << "\n" << flush;
+    while (true) {
+        int fd = accept(listener, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        thread(serveConnection, controller, fd).detach();
+    }
+    close(listener);
+    return 0;
+}
+
+// Round-trip latency of task admission queries from concurrent clients
+int bench(const string& path, int requests, int clients) {
+    vector<vector<double>> latencies(clients);
+    vector<thread> threads;
+    atomic<bool> failed(false);
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c]() {
+            int fd = openSocket(path, false);
+            if (fd < 0) {
+                failed = true;
+                return;
+            }
+            char buffer[REQUEST_HEADER + MAX_VALUES * sizeof(float)];
+            char reply[RESPONSE_SIZE];
+            Request request{QueryTask, 4, 0, 1000, {}};
+            latencies[c].reserve(requests);
+            for (int i = 0; i < requests; ++i) {
+                request.tag = static_cast<uint32_t>(i);
+                request.values[0] = static_cast<float>(10 + i % 50); // Period
+                request.values[1] = request.values[0]; // Deadline
+                request.values[2] = static_cast<float>(1 + i % 4);
+                request.values[3] = static_cast<float>(1 + i % 3);
+                size_t size = encodeRequest(request, buffer);
+                auto start = chrono::steady_clock::now();
+                if (send(fd, buffer, size, MSG_NOSIGNAL) != static_cast<ssize_t>(size) ||
+                    recv(fd, reply, sizeof(reply), 0) != static_cast<ssize_t>(sizeof(reply)) ||
+                    decodeResponse(reply).tag != request.tag) {
+                    failed = true;
+                    break;
+                }
+                latencies[c].push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+            }
+            close(fd);
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+    if (failed) {
+        cerr << "Request failed; is the service running on " << path << "?\n";
+        return 1;
+    }
+
+    vector<double> all;
+    for (const auto& client : latencies)
+        all.insert(all.end(), client.begin(), client.end());
+    if (all.empty())
+        return 0;
+    sort(all.begin(), all.end());
+    auto percentile = [&](double q) { return all[min(all.size() - 1, static_cast<size_t>(q * all.size()))]; };
+    cout << "Requests: " << all.size() << ", Clients: " << clients << "\n";
+    cout << "Latency p50: " << percentile(0.50) << " us, p99: " << percentile(0.99) << " us, max: " << all.back() << " us\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "Usage: " << argv[0] << " serve <socket_path>\n"
+             << "       " << argv[0] << " bench <socket_path> [requests] [clients]\n";
+        return 2;
+    }
+    string mode = argv[1];
+    if (mode == "serve")
+        return serve(argv[2]);
+    if (mode == "bench")
+        return bench(argv[2], argc > 3 ? atoi(argv[3]) : 10000, argc > 4 ? max(1, atoi(argv[4])) : 4);
+    cerr << "Unknown mode: " << mode << "\n";
+    return 2;
+}
@@ -0,0 +1,319 @@
+#ifndef BUS_ROUTING_H
+#define BUS_ROUTING_H
+
+#include <vector>
+#include <queue>
+#include <limits>
+#include <cstdlib>
+#include <new>
+#include <functional>
+#include <algorithm>
+#include <string>
+#include <stdexcept>
+
+#include "Scheduling_engine.h"
+
+// Communication costs across several buses joined by gateway stages.
+//
+// A stage is attached to a bus when the bus has a non-negative cost entry for
+// it, and a stage attached to more than one bus acts as a gateway between
+// them. Sending from stage s to stage d directly over bus b costs
+// costs[s] + costs[d] on that bus, as in calculateMessageSchedule().
+// RoutingTable computes all-pairs multi-hop routes once, so looking up the cost
+// and first bus of any message afterwards is a pair of array reads.
+
+// Minimal allocator returning cache-line aligned storage
+template <class T, std::size_t Align = 64>
+struct AlignedAllocator {
+    typedef T value_type;
+    template <class U> struct rebind { typedef AlignedAllocator<U, Align> other; };
+
+    AlignedAllocator() {}
+    template <class U> AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+    T* allocate(std::size_t n) {
+        void* p = nullptr;
+        std::size_t bytes = n * sizeof(T);
+        if (posix_memalign(&p, Align, bytes > 0 ? bytes : Align) != 0)
+            throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+    void deallocate(T* p, std::size_t) { std::free(p); }
+
+    template <class U> bool operator==(const AlignedAllocator<U, Align>&) const { return true; }
+    template <class U> bool operator!=(const AlignedAllocator<U, Align>&) const { return false; }
+};
+
+typedef std::vector<float, AlignedAllocator<float>> AlignedFloats;
+typedef std::vector<int, AlignedAllocator<int>> AlignedInts;
+
+const float kNoRoute = std::numeric_limits<float>::infinity();
+
+// Flat stage x stage x bus matrix of single-hop costs, kNoRoute where either
+// stage is not attached to the bus. The buses of one (source, destination)
+// pair are contiguous, and each source stage's block is padded to a whole
+// number of cache lines.
+class CommunicationCosts {
+public:
+    // num_stages defaults to the longest cost list of any bus
+    explicit CommunicationCosts(const std::vector<Bus>& buses, int num_stages = 0)
+        : stages_(num_stages), buses_(static_cast<int>(buses.size())) {
+        for (const auto& bus : buses)
+            stages_ = std::max(stages_, static_cast<int>(bus.costs.size()));
+        row_stride_ = (static_cast<std::size_t>(stages_) * buses_ + 15) / 16 * 16;
+        cost_.assign(static_cast<std::size_t>(stages_) * row_stride_, kNoRoute);
+
+        for (int b = 0; b < buses_; ++b) {
+            const std::vector<float>& costs = buses[b].costs;
+            for (int s = 0; s < static_cast<int>(costs.size()); ++s) {
+                if (costs[s] < 0)
+                    continue;
+                for (int d = 0; d < static_cast<int>(costs.size()); ++d)
+                    if (costs[d] >= 0 && d != s)
+                        cost_[offset(s, d) + b] = costs[s] + costs[d];
+            }
+        }
+    }
+
+    int stages() const { return stages_; }
+    int buses() const { return buses_; }
+
+    // Stages are 1-based, buses are indices into the bus list
+    float direct(int source, int destination, int bus) const {
+        return cost_[offset(source - 1, destination - 1) + bus];
+    }
+
+    // Cheapest single hop between two stages, kNoRoute if they share no bus
+    float cheapest(int source, int destination, int* bus = nullptr) const {
+        const float* row = &cost_[offset(source - 1, destination - 1)];
+        float best = kNoRoute;
+        int best_bus = -1;
+        for (int b = 0; b < buses_; ++b) {
+            if (row[b] < best) {
+                best = row[b];
+                best_bus = b;
+            }
+        }
+        if (bus)
+            *bus = best_bus;
+        return best;
+    }
+
+private:
+    std::size_t offset(int s, int d) const {
+        return static_cast<std::size_t>(s) * row_stride_ + static_cast<std::size_t>(d) * buses_;
+    }
+
+    int stages_;
+    int buses_;
+    std::size_t row_stride_; // Floats per source stage
+    AlignedFloats cost_;
+};
+
+// One hop of a route
+struct RouteHop {
+    int from; // Stage
+    int to; // Stage
+    int bus; // Index into the bus list
+    float cost;
+};
+
+// All-pairs cheapest routes over the gateway graph. Floyd-Warshall is used for
+// dense graphs and one Dijkstra run per source for sparse ones.
+class RoutingTable {
+public:
+    enum Method { Auto, FloydWarshall, Dijkstra };
+
+    explicit RoutingTable(const CommunicationCosts& costs, Method method = Auto)
+        : stages_(costs.stages()),
+          cost_(static_cast<std::size_t>(stages_) * stages_, kNoRoute),
+          next_(static_cast<std::size_t>(stages_) * stages_, -1),
+          bus_(static_cast<std::size_t>(stages_) * stages_, -1) {
+        // Single-hop edges
+        std::vector<std::vector<std::pair<int, float>>> adjacency(stages_);
+        long long edges = 0;
+        for (int s = 0; s < stages_; ++s) {
+            cost_[at(s, s)] = 0;
+            next_[at(s, s)] = s;
+            for (int d = 0; d < stages_; ++d) {
+                if (d == s)
+                    continue;
+                int bus;
+                float c = costs.cheapest(s + 1, d + 1, &bus);
+                if (c == kNoRoute)
+                    continue;
+                cost_[at(s, d)] = c;
+                next_[at(s, d)] = d;
+                bus_[at(s, d)] = bus;
+                adjacency[s].push_back({d, c});
+                ++edges;
+            }
+        }
+
+        if (method == Auto)
+            method = edges * 4 >= static_cast<long long>(stages_) * stages_ ? FloydWarshall : Dijkstra;
+        if (method == FloydWarshall)
+            floydWarshall();
+        else
+            dijkstra(adjacency);
+    }
+
+    int stages() const { return stages_; }
+
+    // Stages are 1-based
+    float cost(int source, int destination) const { return cost_[at(source - 1, destination - 1)]; }
+    bool reachable(int source, int destination) const { return cost(source, destination) != kNoRoute; }
+
+    // Bus of the first hop, -1 when unreachable or source == destination
+    int firstBus(int source, int destination) const {
+        int next = next_[at(source - 1, destination - 1)];
+        if (next < 0 || next == source - 1)
+            return -1;
+        return bus_[at(source - 1, next)];
+    }
+
+    std::vector<RouteHop> route(int source, int destination) const {
+        std::vector<RouteHop> hops;
+        int s = source - 1;
+        int d = destination - 1;
+        if (next_[at(s, d)] < 0)
+            return hops;
+        while (s != d) {
+            int n = next_[at(s, d)];
+            hops.push_back({s + 1, n + 1, bus_[at(s, n)], cost_[at(s, n)]});
+            s = n;
+        }
+        return hops;
+    }
+
+private:
+    std::size_t at(int s, int d) const { return static_cast<std::size_t>(s) * stages_ + d; }
+
+    void floydWarshall() {
+        // Route edges keep their single-hop bus; next_ is the first stage after s
+        for (int k = 0; k < stages_; ++k) {
+            const float* row_k = &cost_[at(k, 0)];
+            for (int i = 0; i < stages_; ++i) {
+                float ik = cost_[at(i, k)];
+                if (ik == kNoRoute)
+                    continue;
+                float* row_i = &cost_[at(i, 0)];
+                int* next_i = &next_[at(i, 0)];
+                int via = next_i[k];
+                for (int j = 0; j < stages_; ++j) {
+                    float candidate = ik + row_k[j];
+                    if (candidate < row_i[j]) {
+                        row_i[j] = candidate;
+                        next_i[j] = via;
+                    }
+                }
+            }
+        }
+    }
+
+    void dijkstra(const std::vector<std::vector<std::pair<int, float>>>& adjacency) {
+        typedef std::pair<float, int> Entry;
+        std::vector<float> dist(stages_);
+        std::vector<int> parent(stages_);
+        std::vector<int> settled;
+        settled.reserve(stages_);
+
+        for (int s = 0; s < stages_; ++s) {
+            std::fill(dist.begin(), dist.end(), kNoRoute);
+            std::fill(parent.begin(), parent.end(), -1);
+            settled.clear();
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+            dist[s] = 0;
+            queue.push({0, s});
+            while (!queue.empty()) {
+                Entry top = queue.top();
+                queue.pop();
+                int u = top.second;
+                if (top.first > dist[u])
+                    continue;
+                settled.push_back(u);
+                for (const auto& edge : adjacency[u]) {
+                    float candidate = dist[u] + edge.second;
+                    if (candidate < dist[edge.first]) {
+                        dist[edge.first] = candidate;
+                        parent[edge.first] = u;
+                        queue.push({candidate, edge.first});
+                    }
+                }
+            }
+            // Settled order guarantees a parent's first hop is known before its children's
+            for (int v : settled) {
+                cost_[at(s, v)] = dist[v];
+                if (v != s)
+                    next_[at(s, v)] = parent[v] == s ? v : next_[at(s, parent[v])];
+            }
+        }
+    }
+
+    int stages_;
+    AlignedFloats cost_; // Route cost, stage x stage; equals the edge cost along any first hop
+    AlignedInts next_; // First stage after the source on the route
+    AlignedInts bus_; // Bus of the single-hop edge, stage x stage
+};
+
+// Bus policy using precomputed multi-hop routes. A message is stored and
+// forwarded along its cheapest route: each hop is reserved on its own bus for
+// the hop cost plus the message's transmission time, starting once the
+// previous hop has arrived and the bus is free. Reservations are appended to
+// each bus, so an idle gap left before a later reservation is not reused. The
+// returned slot names the first bus and spans the whole route. A message
+// between stages that are unknown or not connected throws, so no schedule is
+// produced with an unroutable message in it.
+class RoutedBus {
+public:
+    struct Reservation {
+        int message; // Message ID
+        int hop; // Position of the hop on the message's route
+        float start;
+        float finish;
+    };
+
+    explicit RoutedBus(const std::vector<Bus>& buses)
+        : routes_(CommunicationCosts(buses)), busy_until_(buses.size(), 0), timelines_(buses.size()) {}
+
+    BusSlot assign(const Message& message, float ready) {
+        if (!inRange(message.source) || !inRange(message.destination))
+            throw std::runtime_error(unroutable(message, "unknown stage"));
+        if (message.source == message.destination)
+            return {0, ready, ready};
+        std::vector<RouteHop> hops = routes_.route(message.source, message.destination);
+        if (hops.empty())
+            throw std::runtime_error(unroutable(message, "stages not connected"));
+
+        float start = 0;
+        float arrival = ready;
+        for (int h = 0; h < static_cast<int>(hops.size()); ++h) {
+            const int bus = hops[h].bus;
+            const float hop_start = std::max(arrival, busy_until_[bus]);
+            arrival = hop_start + hops[h].cost + message.transmission_time;
+            busy_until_[bus] = arrival;
+            timelines_[bus].push_back({message.id, h, hop_start, arrival});
+            if (h == 0)
+                start = hop_start;
+        }
+        return {hops.front().bus, start, arrival};
+    }
+
+    const RoutingTable& routes() const { return routes_; }
+
+    // Hops reserved on a bus, in increasing start time
+    const std::vector<Reservation>& timeline(int bus) const { return timelines_[bus]; }
+
+private:
+    bool inRange(int stage) const { return stage >= 1 && stage <= routes_.stages(); }
+    static std::string unroutable(const Message& message, const char* reason) {
+        return "message " + std::to_string(message.id) + " from stage " + std::to_string(message.source) +
+               " to stage " + std::to_string(message.destination) + " cannot be routed: " + reason;
+    }
+
+    RoutingTable routes_;
+    std::vector<float> busy_until_; // Per bus, end of its last reservation
+    std::vector<std::vector<Reservation>> timelines_;
+};
+
+#endif // BUS_ROUTING_H
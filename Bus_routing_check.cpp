@@ -0,0 +1,75 @@
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include "Scheduling_engine.h"
+#include "Bus_routing.h"
+
+using namespace std;
+
+// Regression cases for RoutedBus. Exits nonzero if any case fails.
+//
+// Usage: Bus_routing_check
+
+// No two reservations on a bus overlap
+bool disjoint(const RoutedBus& policy, int num_buses) {
+    for (int b = 0; b < num_buses; ++b) {
+        const vector<RoutedBus::Reservation>& timeline = policy.timeline(b);
+        for (size_t i = 1; i < timeline.size(); ++i)
+            if (timeline[i].start < timeline[i - 1].finish)
+                return false;
+    }
+    return true;
+}
+
+// Stages 1 and 2 each reach stage 4 through gateway stage 3, so both routes
+// end with the same hop on bus 2. The second message has to wait for the
+// first one to leave that bus, and every hop carries the transmission time.
+bool sharedSecondHop() {
+    vector<Bus> buses = {
+        {1, 0, {1, -1, 1}}, // Stages 1 and 3
+        {2, 0, {-1, 1, 1}}, // Stages 2 and 3
+        {3, 0, {-1, -1, 1, 1}}, // Stages 3 and 4
+    };
+    RoutedBus policy(buses);
+    Message first{1, 1, 4, 1, 0, 0, -1};
+    Message second{2, 2, 4, 1, 0, 0, -1};
+    BusSlot a = policy.assign(first, 0);
+    BusSlot b = policy.assign(second, 0);
+    // Each hop costs 2 plus the transmission time of 1
+    return a.bus == 0 && a.start == 0 && a.finish == 6 && b.bus == 1 && b.start == 0 && b.finish == 9 &&
+           policy.timeline(2).size() == 2 && disjoint(policy, 3);
+}
+
+// A message between stages that share no bus path must not be scheduled
+bool unroutableThrows() {
+    vector<Bus> buses = {
+        {1, 0, {1, 1}},
+        {2, 0, {-1, -1, 1, 1}},
+    };
+    RoutedBus policy(buses);
+    try {
+        policy.assign(Message{1, 1, 4, 0, 0, 0, -1}, 0);
+    } catch (const runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    struct Case {
+        const char* name;
+        bool (*run)();
+    };
+    const Case cases[] = {
+        {"routes sharing a second hop", sharedSecondHop},
+        {"unroutable message", unroutableThrows},
+    };
+    int failures = 0;
+    for (const Case& c : cases) {
+        bool passed = c.run();
+        cout << (passed ? "PASS " : "FAIL ") << c.name << "\n";
+        failures += !passed;
+    }
+    return failures ? 1 : 0;
+}
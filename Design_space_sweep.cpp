@@ -0,0 +1,317 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+#include "Scheduling_engine.h"
+#include "Schedulability_analysis.h"
+#include "Message_framing.h"
+#include "Sweep_cache.h"
+
+using namespace std;
+
+// Design-space exploration: evaluate every combination of processor count,
+// bus set and framing parameters (Tc, max_sl_s) in parallel. Each pipeline
+// stage is memoized by a content hash of its inputs, so points sharing a task
+// set and processor count reuse the task schedule, points that also share a
+// bus set reuse the message schedule, and framing is computed once per
+// (Tc, max_sl_s). The cache is reloaded from and saved back to disk.
+//
+// Usage: Design_space_sweep [cache_file] [threads]
+
+using Scheduler = SchedulingEngine<PeriodRank, EarliestAvailableProcessor, EarliestFinishBus, SourceEftEst>;
+
+// Mixed into every cache key: the Scheduler policies plus a hash of this
+// executable, which contains every stage's code (engine, analysis, framing),
+// so any rebuild that changes the code invalidates the persisted cache on its
+// own. Where the executable cannot be read, the compile time stands in.
+const string& pipelineTag() {
+    static const string tag = []() {
+        string text = "PeriodRank EarliestAvailableProcessor EarliestFinishBus SourceEftEst";
+        ifstream exe("/proc/self/exe", ios::binary);
+        if (!exe)
+            return text + " built " + __DATE__ + " " + __TIME__;
+        ContentHash hash;
+        char chunk[1 << 16];
+        while (exe.read(chunk, sizeof(chunk)) || exe.gcount() > 0)
+            hash.bytes(chunk, static_cast<size_t>(exe.gcount()));
+        return text + " exe " + to_string(hash.value()) + "/" + to_string(hash.check());
+    }();
+    return tag;
+}
+
+struct SweepPoint {
+    int num_processors;
+    int bus_set;
+    int Tc;
+    int max_sl_s;
+};
+
+struct SweepOutcome {
+    float makespan; // Latest task finish
+    float message_finish; // Latest message finish
+    int schedulable_processors;
+    int optimal_slot_size;
+};
+
+ContentHash& hashTasks(ContentHash& hash, const vector<PeriodicTask>& tasks) {
+    hash.add(static_cast<int>(tasks.size()));
+    for (const auto& task : tasks)
+        hash.add(task.id).add(task.period).add(task.deadline).add(task.processing_time).add(task.next_release);
+    return hash;
+}
+
+ContentHash& hashMessages(ContentHash& hash, const vector<Message>& messages) {
+    hash.add(static_cast<int>(messages.size()));
+    for (const auto& message : messages)
+        hash.add(message.id).add(message.source).add(message.destination).add(message.transmission_time);
+    return hash;
+}
+
+ContentHash& hashBuses(ContentHash& hash, const vector<Bus>& buses) {
+    hash.add(static_cast<int>(buses.size()));
+    for (const auto& bus : buses)
+        hash.add(bus.id).add(bus.communication_time).add(bus.costs);
+    return hash;
+}
+
+class SweepPipeline {
+public:
+    SweepPipeline(const vector<PeriodicTask>& tasks, const vector<Message>& messages,
+                  const vector<vector<Bus>>& bus_sets, const vector<Signal>& signals, ResultCache& cache)
+        : tasks_(tasks), messages_(messages), bus_sets_(bus_sets), signals_(signals), cache_(cache) {
+        tasks_hash_ = stageHash("tasks");
+        hashTasks(tasks_hash_, tasks_);
+    }
+
+    SweepOutcome evaluate(const SweepPoint& point) {
+        vector<PeriodicTask> tasks = scheduledTasks(point.num_processors);
+        vector<Message> messages = scheduledMessages(tasks, point.num_processors, point.bus_set);
+
+        SweepOutcome outcome = {0, 0, 0, 0};
+        for (const auto& task : tasks)
+            outcome.makespan = max(outcome.makespan, task.eft);
+        for (const auto& message : messages)
+            outcome.message_finish = max(outcome.message_finish, message.eft);
+        for (const auto& processor : analyseProcessors(tasks, point.num_processors))
+            outcome.schedulable_processors += processor.schedulable;
+        outcome.optimal_slot_size = optimalSlotSize(point.Tc, point.max_sl_s);
+        return outcome;
+    }
+
+private:
+    // Rank order of the task set: IDs and ranks
+    vector<PeriodicTask> rankedTasks() {
+        string blob = cache_.getOrCompute(taskStageHash("rank"), [&]() {
+            vector<PeriodicTask> tasks = tasks_;
+            for (auto& task : tasks)
+                task.rank = PeriodRank::rank(task);
+            stable_sort(tasks.begin(), tasks.end(), [](const PeriodicTask& a, const PeriodicTask& b) {
+                return a.rank < b.rank;
+            });
+            ByteWriter out;
+            for (const auto& task : tasks)
+                out.put(task.id).put(task.rank);
+            return out.str();
+        });
+
+        vector<PeriodicTask> ranked;
+        ranked.reserve(tasks_.size());
+        ByteReader in(blob);
+        for (size_t i = 0; i < tasks_.size(); ++i) {
+            int id = in.get<int>();
+            float rank = in.get<float>();
+            ranked.push_back(taskById(id));
+            ranked.back().rank = rank;
+        }
+        return ranked;
+    }
+
+    // Partial schedule of the tasks on num_processors processors
+    vector<PeriodicTask> scheduledTasks(int num_processors) {
+        string blob = cache_.getOrCompute(taskStageHash("schedule").add(num_processors), [&]() {
+            vector<PeriodicTask> tasks = rankedTasks();
+            Scheduler::schedulePeriodicTasks(tasks, num_processors, false);
+            ByteWriter out;
+            for (const auto& task : tasks)
+                out.put(task.id).put(task.rank).put(task.est).put(task.eft).put(task.processor).put(task.next_release);
+            return out.str();
+        });
+
+        vector<PeriodicTask> tasks;
+        tasks.reserve(tasks_.size());
+        ByteReader in(blob);
+        for (size_t i = 0; i < tasks_.size(); ++i) {
+            tasks.push_back(taskById(in.get<int>()));
+            PeriodicTask& task = tasks.back();
+            task.rank = in.get<float>();
+            task.est = in.get<float>();
+            task.eft = in.get<float>();
+            task.processor = in.get<int>();
+            task.next_release = in.get<float>();
+        }
+        return tasks;
+    }
+
+    // Message placements on a bus set, given the task schedule
+    vector<Message> scheduledMessages(const vector<PeriodicTask>& tasks, int num_processors, int bus_set) {
+        ContentHash hash = taskStageHash("messages");
+        hash.add(num_processors);
+        hashMessages(hash, messages_);
+        hashBuses(hash, bus_sets_[bus_set]);
+        string blob = cache_.getOrCompute(hash, [&]() {
+            vector<Message> messages = messages_;
+            Scheduler::scheduleMessages(messages, bus_sets_[bus_set], tasks, false);
+            ByteWriter out;
+            for (const auto& message : messages)
+                out.put(message.bus).put(message.est).put(message.eft);
+            return out.str();
+        });
+
+        vector<Message> messages = messages_;
+        ByteReader in(blob);
+        for (auto& message : messages) {
+            message.bus = in.get<int>();
+            message.est = in.get<float>();
+            message.eft = in.get<float>();
+        }
+        return messages;
+    }
+
+    int optimalSlotSize(int Tc, int max_sl_s) {
+        ContentHash hash = stageHash("framing");
+        hash.add(Tc).add(max_sl_s).add(static_cast<int>(signals_.size()));
+        for (const auto& signal : signals_)
+            hash.add(signal.id).add(signal.size).add(signal.period);
+        string blob = cache_.getOrCompute(hash, [&]() {
+            return ByteWriter().put(findOptimalSlotSize(signals_, Tc, max_sl_s)).str();
+        });
+        return ByteReader(blob).get<int>();
+    }
+
+    static ContentHash stageHash(const char* stage) {
+        ContentHash hash;
+        hash.add(pipelineTag()).add(string(stage));
+        return hash;
+    }
+
+    // Stage over the task set; both of its hashes go in, so a collision of one
+    // does not carry into the stage keys
+    ContentHash taskStageHash(const char* stage) const {
+        ContentHash hash = stageHash(stage);
+        hash.add(tasks_hash_.value()).add(tasks_hash_.check());
+        return hash;
+    }
+
+    const PeriodicTask& taskById(int id) const {
+        for (const auto& task : tasks_)
+            if (task.id == id)
+                return task;
+        throw runtime_error("Cached schedule refers to unknown task " + to_string(id));
+    }
+
+    const vector<PeriodicTask>& tasks_;
+    const vector<Message>& messages_;
+    const vector<vector<Bus>>& bus_sets_;
+    const vector<Signal>& signals_;
+    ResultCache& cache_;
+    ContentHash tasks_hash_;
+};
+
+int main(int argc, char* argv[]) {
+    string cache_file = argc > 1 ? argv[1] : "sweep_cache.bin";
+    unsigned threads = argc > 2 ? static_cast<unsigned>(atoi(argv[2])) : thread::hardware_concurrency();
+    if (threads == 0)
+        threads = 1;
+
+    // Example workload: rate monotonic tasks with heterogeneous processing
+    // times, a pipeline of messages between them, and the framing signals
+    const int max_processors = 8;
+    mt19937 rng(2024);
+    const float periods[] = {5, 10, 20, 25, 50, 100};
+    vector<PeriodicTask> tasks;
+    for (int i = 1; i <= 40; ++i) {
+        float period = periods[rng() % 6];
+        vector<float> processing_time;
+        for (int p = 0; p < max_processors; ++p)
+            processing_time.push_back(period * (0.02f + 0.01f * (rng() % 5)));
+        tasks.push_back({i, period, period, processing_time, 0});
+    }
+    vector<Message> messages;
+    for (int i = 1; i <= 60; ++i) {
+        int source = 1 + rng() % 39;
+        int destination = source + 1 + rng() % (40 - source);
+        messages.push_back({i, source, destination, 0.5f + 0.5f * (rng() % 4)});
+    }
+    vector<vector<Bus>> bus_sets = {
+        {{1, 1}},
+        {{1, 1}, {2, 2}},
+        {{1, 1}, {2, 1}, {3, 2}, {4, 3}},
+    };
+    vector<Signal> signals = {
+        Signal(1, 2, 10), Signal(2, 3, 5), Signal(3, 1, 20),
+        Signal(4, 2, 10), Signal(5, 3, 5), Signal(6, 1, 20)
+    };
+    int Tc = totalCycleLength(signals);
+    int max_sl_s = maxAggregateSlotSize(signals, Tc);
+
+    vector<SweepPoint> grid;
+    for (int num_processors : {1, 2, 4, 8})
+        for (int bus_set = 0; bus_set < static_cast<int>(bus_sets.size()); ++bus_set)
+            for (int tc : {Tc, 2 * Tc, 4 * Tc})
+                for (int sl : {max_sl_s, max_sl_s + 2})
+                    grid.push_back({num_processors, bus_set, tc, sl});
+
+    ResultCache cache;
+    bool loaded = cache.load(cache_file);
+    SweepPipeline pipeline(tasks, messages, bus_sets, signals, cache);
+
+    auto start = chrono::steady_clock::now();
+    vector<SweepOutcome> outcomes(grid.size());
+    atomic<size_t> next(0);
+    vector<thread> workers;
+    vector<string> errors(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            try {
+                for (size_t i = next++; i < grid.size(); i = next++)
+                    outcomes[i] = pipeline.evaluate(grid[i]);
+            } catch (const exception& e) {
+                errors[t] = e.what();
+                next = grid.size();
+            }
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+    for (const auto& error : errors) {
+        if (!error.empty()) {
+            cerr << "Sweep failed: " << error << (loaded ? " (delete " + cache_file + " and rerun)" : "") << "\n";
+            return 1;
+        }
+    }
+    double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "Design space sweep: " << grid.size() << " points on " << threads << " threads\n\n";
+    cout << "Processors\tBuses\tTc\tmax_sl_s\tMakespan\tMessages done\tSchedulable\tSlot size\n";
+    for (size_t i = 0; i < grid.size(); ++i) {
+        const SweepPoint& point = grid[i];
+        const SweepOutcome& outcome = outcomes[i];
+        cout << point.num_processors << "\t\t" << bus_sets[point.bus_set].size() << "\t" << point.Tc << "\t"
+             << point.max_sl_s << "\t\t" << outcome.makespan << "\t\t" << outcome.message_finish << "\t\t"
+             << outcome.schedulable_processors << "/" << point.num_processors << "\t\t" << outcome.optimal_slot_size << "\n";
+    }
+    cout << "\nCache: " << cache.hits() << " hits, " << cache.misses() << " misses, " << cache.size() << " entries"
+         << (loaded ? " (reloaded from " + cache_file + ")" : "") << "\n";
+    cout << "Sweep time: " << elapsed << " ms\n";
+
+    if (!cache.save(cache_file))
+        cerr << "Could not save cache to " << cache_file << "\n";
+    return 0;
+}
@@ -0,0 +1,239 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <sys/resource.h>
+
+#include "Message_framing.h"
+
+using namespace std;
+
+// Scalability benchmark of the FlexRay framing stages on synthetic automotive
+// signal sets.
+//
+// Signals are drawn from a period mix and a size distribution:
+//   sae        - the SAE benchmark periods 5, 10, 100 and 1000 ms
+//   powertrain - the period shares published for an engine-control
+//                application (1 ms to 1 s, dominated by 10, 20 and 100 ms)
+// Periods are expressed in 100 us ticks so that the cycle length leaves room
+// for more than one slot. Every framing stage is timed separately (median of
+// a few runs) with its peak resident memory, and the framed message sets are
+// packed into equal-size frames to report bandwidth utilization.
+//
+// Usage: Framing_benchmark [json_file] [sae|powertrain] [signal counts...]
+
+const int TICKS_PER_MS = 10;
+const int REPEATS = 3;
+
+struct PeriodShare {
+    int period_ms;
+    double weight;
+};
+
+vector<Signal> generateSignals(int count, const string& mix, unsigned seed) {
+    static const vector<PeriodShare> sae = {{5, 20}, {10, 35}, {100, 35}, {1000, 10}};
+    static const vector<PeriodShare> powertrain = {{1, 3}, {2, 2}, {5, 2}, {10, 25}, {20, 25},
+                                                   {50, 3}, {100, 20}, {200, 1}, {1000, 4}};
+    const vector<PeriodShare>& shares = mix == "powertrain" ? powertrain : sae; // main() rejects other mixes
+    vector<double> weights;
+    for (const auto& share : shares)
+        weights.push_back(share.weight);
+
+    // Mostly one- and two-byte signals, a few wide ones
+    static const int sizes[] = {1, 2, 4, 8};
+    mt19937 random(seed);
+    discrete_distribution<int> pick_period(weights.begin(), weights.end());
+    discrete_distribution<int> pick_size({40, 30, 20, 10});
+
+    vector<Signal> signals;
+    signals.reserve(count);
+    for (int i = 0; i < count; ++i)
+        signals.emplace_back(i + 1, sizes[pick_size(random)], shares[pick_period(random)].period_ms * TICKS_PER_MS);
+    return signals;
+}
+
+// Peak resident set size in KiB since the last reset
+long peakRssKb() {
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line))
+        if (line.compare(0, 6, "VmHWM:") == 0)
+            return atol(line.c_str() + 6);
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Reset the peak to the current resident size where the kernel allows it
+void resetPeakRss() {
+    ofstream clear("/proc/self/clear_refs");
+    if (clear)
+        clear << "5";
+}
+
+struct StageResult {
+    string name;
+    double seconds; // Median over the runs
+    long peak_rss_kb;
+};
+
+struct FramingUtilization {
+    long long frames; // Frames per cycle of each period, summed over periods
+    int dropped_signals; // Signals larger than the slot
+    double payload_rate; // Signal bytes per ms
+    double frame_rate; // Frame bytes per ms
+};
+
+// Pack each period's signals into frames of slot bytes, best fit decreasing.
+// Sizes never exceed the slot, so open frames are bucketed by free space.
+FramingUtilization packMessageSets(const vector<Signal>& signals, int slot) {
+    FramingUtilization result{0, 0, 0, 0};
+    if (slot <= 0) {
+        result.dropped_signals = static_cast<int>(signals.size());
+        return result;
+    }
+    unordered_map<int, vector<int>> bins; // Sizes by period
+    for (const Signal& signal : signals) {
+        if (signal.size > slot) {
+            ++result.dropped_signals;
+            continue;
+        }
+        bins[signal.period].push_back(signal.size);
+    }
+    for (auto& bin : bins) {
+        vector<int>& sizes = bin.second;
+        sort(sizes.rbegin(), sizes.rend());
+        vector<long long> open(slot + 1, 0); // Frames by free bytes
+        long long frames = 0;
+        long long payload = 0;
+        for (int size : sizes) {
+            payload += size;
+            int free = size;
+            while (free <= slot && open[free] == 0)
+                ++free;
+            if (free > slot) {
+                ++frames;
+                free = slot;
+            } else {
+                --open[free];
+            }
+            ++open[free - size];
+        }
+        double period_ms = static_cast<double>(bin.first) / TICKS_PER_MS;
+        result.frames += frames;
+        result.payload_rate += payload / period_ms;
+        result.frame_rate += frames * slot / period_ms;
+    }
+    return result;
+}
+
+template <class Stage>
+StageResult timeStage(const string& name, Stage stage) {
+    vector<double> runs;
+    long peak = 0;
+    for (int r = 0; r < REPEATS; ++r) {
+        resetPeakRss();
+        auto start = chrono::steady_clock::now();
+        stage();
+        runs.push_back(chrono::duration<double>(chrono::steady_clock::now() - start).count());
+        peak = max(peak, peakRssKb());
+    }
+    sort(runs.begin(), runs.end());
+    return {name, runs[runs.size() / 2], peak};
+}
+
+struct BenchmarkCase {
+    int signals;
+    int Tc;
+    int max_sl_s;
+    long long coprime_pairs;
+    int optimal_slot_size;
+    FramingUtilization utilization;
+    vector<StageResult> stages;
+};
+
+BenchmarkCase runCase(int count, const string& mix) {
+    BenchmarkCase result;
+    result.signals = count;
+    vector<Signal> signals;
+    vector<int> periods;
+
+    result.stages.push_back(timeStage("generate", [&]() { signals = generateSignals(count, mix, 2024); }));
+    periods.reserve(signals.size());
+    for (const Signal& signal : signals)
+        periods.push_back(signal.period);
+
+    result.stages.push_back(timeStage("total_cycle_length", [&]() { result.Tc = totalCycleLength(signals); }));
+    result.stages.push_back(timeStage("max_aggregate_slot_size", [&]() { result.max_sl_s = maxAggregateSlotSize(signals, result.Tc); }));
+    result.stages.push_back(timeStage("count_coprime_periodicities", [&]() { result.coprime_pairs = countCoprimePeriodicities(periods); }));
+    result.stages.push_back(timeStage("find_optimal_slot_size", [&]() {
+        result.optimal_slot_size = findOptimalSlotSize(signals, result.Tc, result.max_sl_s);
+    }));
+    result.stages.push_back(timeStage("pack_message_sets", [&]() {
+        result.utilization = packMessageSets(signals, result.optimal_slot_size);
+    }));
+    return result;
+}
+
+void writeJson(const vector<BenchmarkCase>& cases, const string& mix, const string& path) {
+    ofstream out(path);
+    char number[64];
+    out << "{\"benchmark\":\"framing\",\"mix\":\"" << mix << "\",\"ticks_per_ms\":" << TICKS_PER_MS
+        << ",\"repeats\":" << REPEATS << ",\"cases\":[";
+    for (size_t c = 0; c < cases.size(); ++c) {
+        const BenchmarkCase& bc = cases[c];
+        const FramingUtilization& u = bc.utilization;
+        snprintf(number, sizeof(number), "%.6f", u.frame_rate > 0 ? u.payload_rate / u.frame_rate : 0.0);
+        out << (c ? ",\n" : "\n") << "{\"signals\":" << bc.signals << ",\"Tc\":" << bc.Tc << ",\"max_sl_s\":" << bc.max_sl_s
+            << ",\"coprime_pairs\":" << bc.coprime_pairs << ",\"optimal_slot_size\":" << bc.optimal_slot_size
+            << ",\"frames\":" << u.frames << ",\"dropped_signals\":" << u.dropped_signals
+            << ",\"bandwidth_utilization\":" << number << ",\"stages\":[";
+        for (size_t s = 0; s < bc.stages.size(); ++s) {
+            snprintf(number, sizeof(number), "%.9f", bc.stages[s].seconds);
+            out << (s ? "," : "") << "{\"name\":\"" << bc.stages[s].name << "\",\"seconds\":" << number
+                << ",\"peak_rss_kb\":" << bc.stages[s].peak_rss_kb << "}";
+        }
+        out << "]}";
+    }
+    out << "\n]}\n";
+}
+
+int main(int argc, char* argv[]) {
+    string json_path = argc > 1 ? argv[1] : "framing_benchmark.json";
+    string mix = argc > 2 ? argv[2] : "sae";
+    if (mix != "sae" && mix != "powertrain") {
+        cerr << "Unknown signal mix: " << mix << " (expected sae or powertrain)\n";
+        return 2;
+    }
+    vector<int> counts;
+    for (int i = 3; i < argc; ++i) {
+        counts.push_back(atoi(argv[i]));
+        if (counts.back() <= 0) {
+            cerr << "Invalid signal count: " << argv[i] << "\n";
+            return 2;
+        }
+    }
+    if (counts.empty())
+        counts = {1000, 10000, 50000, 200000};
+
+    vector<BenchmarkCase> cases;
+    for (int count : counts) {
+        cases.push_back(runCase(count, mix));
+        const BenchmarkCase& bc = cases.back();
+        const FramingUtilization& u = bc.utilization;
+        cout << "Signals: " << bc.signals << ", Tc: " << bc.Tc << ", max_sl_s: " << bc.max_sl_s
+             << ", Optimal slot size: " << bc.optimal_slot_size << " bytes, Frames: " << u.frames
+             << ", Bandwidth utilization: " << (u.frame_rate > 0 ? 100 * u.payload_rate / u.frame_rate : 0) << "%\n";
+        for (const auto& stage : bc.stages)
+            cout << "  " << stage.name << ": " << stage.seconds * 1e3 << " ms, peak RSS " << stage.peak_rss_kb << " KiB\n";
+    }
+    writeJson(cases, mix, json_path);
+    cout << "Results written to " << json_path << "\n";
+    return 0;
+}
@@ -0,0 +1,350 @@
+#ifndef HOLISTIC_ANALYSIS_H
+#define HOLISTIC_ANALYSIS_H
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <string>
+#include <stdexcept>
+
+#include "Scheduling_engine.h"
+
+// Holistic task/message analysis (Tindell & Clark style).
+//
+// Every message forms a chain source task -> message -> destination task.
+// A message inherits the worst-case response of its source task as release
+// jitter, and a destination task inherits the worst-case response of its
+// incoming messages. Task response times are computed with jitter-aware
+// fixed-priority preemptive RTA per processor, message response times with
+// non-preemptive fixed-priority analysis per bus, and the two alternate until
+// the jitters reach a fixed point.
+//
+// Jitters only grow, so each round recomputes just the tasks and messages
+// whose inputs changed: an entity whose own jitter moved, or one sitting
+// below an entity whose jitter moved on the same processor or bus.
+//
+// An unbounded response keeps iterating like any other: its infinite jitter
+// makes every dependent entity unbounded too. If the iteration limit is hit
+// first, the entities still pending and everything depending on them are
+// reported unbounded rather than with values that never settled.
+
+// End-to-end latency bound of one source -> message -> destination chain
+struct ChainLatency {
+    int message; // Message ID
+    int source; // Source stage
+    int destination; // Destination stage
+    double latency; // From source release to destination completion
+    bool bounded;
+};
+
+struct HolisticResult {
+    bool converged; // False if some response time diverged or the iterations ran out
+    int iterations;
+    long long recomputations; // Task and message response computations performed
+    std::vector<double> task_response; // Per task, jitter included, same order as the input
+    std::vector<double> message_response; // Per message, jitter included, same order as the input
+    std::vector<ChainLatency> chains;
+};
+
+namespace holistic_detail {
+
+const double kUnbounded = std::numeric_limits<double>::infinity();
+
+struct Node {
+    int resource; // Processor or bus
+    double cost; // Execution or transmission time
+    double period;
+    double jitter;
+    double window; // Response time measured from release, without jitter
+    double total; // jitter + window
+    bool dirty;
+};
+
+// Indices of nodes per resource, in decreasing priority order
+inline std::vector<std::vector<int>> byResource(const std::vector<Node>& nodes, const std::vector<double>& priority, int num_resources) {
+    std::vector<std::vector<int>> groups(num_resources);
+    for (int i = 0; i < static_cast<int>(nodes.size()); ++i)
+        groups[nodes[i].resource].push_back(i);
+    for (auto& group : groups)
+        std::stable_sort(group.begin(), group.end(), [&](int a, int b) { return priority[a] < priority[b]; });
+    return groups;
+}
+
+// Mark a node and everything below it on its resource for recomputation
+inline void markFrom(std::vector<Node>& nodes, const std::vector<std::vector<int>>& groups, const std::vector<int>& rank, int i) {
+    const std::vector<int>& group = groups[nodes[i].resource];
+    for (int k = rank[i]; k < static_cast<int>(group.size()); ++k)
+        nodes[group[k]].dirty = true;
+}
+
+// Zero-cost entries add no interference and are skipped; an infinite jitter
+// times zero would make the window NaN, which never settles. Any other entry
+// with an unbounded jitter makes the window unbounded outright.
+
+// Preemptive: w = C + sum_hp ceil((w + J_j) / T_j) C_j
+inline double taskWindow(const std::vector<Node>& nodes, const std::vector<int>& group, int position, double limit) {
+    const Node& self = nodes[group[position]];
+    double w = self.cost;
+    while (true) {
+        double demand = self.cost;
+        for (int k = 0; k < position; ++k) {
+            const Node& hp = nodes[group[k]];
+            if (hp.cost == 0)
+                continue;
+            if (std::isinf(hp.jitter))
+                return kUnbounded;
+            demand += std::ceil((w + hp.jitter) / hp.period - 1e-9) * hp.cost;
+        }
+        if (demand > limit)
+            return kUnbounded;
+        if (demand <= w)
+            return w;
+        w = demand;
+    }
+}
+
+// Non-preemptive: q = B + sum_hp ceil((q + J_k + eps) / T_k) C_k, window = q + C
+inline double messageWindow(const std::vector<Node>& nodes, const std::vector<int>& group, int position, double limit) {
+    const Node& self = nodes[group[position]];
+    double blocking = 0;
+    for (int k = position + 1; k < static_cast<int>(group.size()); ++k)
+        blocking = std::max(blocking, nodes[group[k]].cost);
+
+    double q = blocking;
+    while (true) {
+        double demand = blocking;
+        for (int k = 0; k < position; ++k) {
+            const Node& hp = nodes[group[k]];
+            if (hp.cost == 0)
+                continue;
+            if (std::isinf(hp.jitter))
+                return kUnbounded;
+            demand += std::ceil((q + hp.jitter + 1e-6) / hp.period - 1e-9) * hp.cost;
+        }
+        if (demand > limit)
+            return kUnbounded;
+        if (demand <= q)
+            return q + self.cost;
+        q = demand;
+    }
+}
+
+} // namespace holistic_detail
+
+// Tasks must carry the processor and rank set by
+// SchedulingEngine::schedulePeriodicTasks(), messages the bus and EST/EFT set
+// by SchedulingEngine::scheduleMessages(). A message's period is that of its
+// source task (or its destination task when the source stage has no task),
+// and messages on a bus are prioritised rate monotonically.
+inline HolisticResult holisticAnalysis(const std::vector<PeriodicTask>& tasks, int num_processors,
+                                       const std::vector<Message>& messages, int num_buses,
+                                       int max_iterations = 1000) {
+    using namespace holistic_detail;
+
+    const int n = static_cast<int>(tasks.size());
+    const int m = static_cast<int>(messages.size());
+
+    // Stage ID -> task index
+    int max_id = 0;
+    for (const auto& task : tasks)
+        max_id = std::max(max_id, task.id);
+    std::vector<int> by_stage(max_id + 1, -1);
+    for (int i = 0; i < n; ++i)
+        if (tasks[i].id >= 0)
+            by_stage[tasks[i].id] = i;
+    auto lookup = [&](int stage) { return (stage >= 0 && stage <= max_id) ? by_stage[stage] : -1; };
+
+    std::vector<Node> task_nodes(n);
+    std::vector<double> task_priority(n);
+    double period_sum = 0;
+    for (int i = 0; i < n; ++i) {
+        int p = tasks[i].processor;
+        task_nodes[i] = {p, tasks[i].processing_time[p], tasks[i].period, 0, 0, 0, true};
+        task_priority[i] = tasks[i].rank;
+        period_sum += tasks[i].period;
+    }
+
+    std::vector<Node> message_nodes(m);
+    std::vector<double> message_priority(m);
+    std::vector<int> message_source(m), message_destination(m);
+    std::vector<std::vector<int>> incoming(n), outgoing(n);
+    for (int j = 0; j < m; ++j) {
+        const Message& message = messages[j];
+        int src = lookup(message.source);
+        int dst = lookup(message.destination);
+        message_source[j] = src;
+        message_destination[j] = dst;
+        if (src >= 0)
+            outgoing[src].push_back(j);
+        if (dst >= 0)
+            incoming[dst].push_back(j);
+
+        double period = src >= 0 ? tasks[src].period : (dst >= 0 ? tasks[dst].period : kUnbounded);
+        double cost = messageCost(message);
+        if (message.bus < 0 || message.bus >= num_buses)
+            throw std::out_of_range("message " + std::to_string(message.id) + " is not scheduled on one of the " +
+                                    std::to_string(num_buses) + " buses");
+        message_nodes[j] = {message.bus, cost, period, 0, 0, 0, true};
+        message_priority[j] = period;
+    }
+
+    std::vector<std::vector<int>> processors = byResource(task_nodes, task_priority, num_processors);
+    std::vector<std::vector<int>> buses = byResource(message_nodes, message_priority, num_buses);
+    std::vector<int> task_rank(n), message_rank(m);
+    for (const auto& group : processors)
+        for (int k = 0; k < static_cast<int>(group.size()); ++k)
+            task_rank[group[k]] = k;
+    for (const auto& group : buses)
+        for (int k = 0; k < static_cast<int>(group.size()); ++k)
+            message_rank[group[k]] = k;
+
+    // Anything beyond this many periods of busy time is treated as divergence
+    const double limit = 1000.0 * std::max(period_sum, 1.0);
+
+    HolisticResult result;
+    result.converged = true;
+    result.iterations = 0;
+    result.recomputations = 0;
+
+    bool changed = true;
+    while (changed && result.iterations < max_iterations) {
+        changed = false;
+        ++result.iterations;
+
+        // Task phase
+        for (const auto& group : processors) {
+            for (int k = 0; k < static_cast<int>(group.size()); ++k) {
+                Node& node = task_nodes[group[k]];
+                if (!node.dirty)
+                    continue;
+                node.dirty = false;
+                ++result.recomputations;
+                node.window = taskWindow(task_nodes, group, k, limit);
+                double total = node.jitter + node.window;
+                if (total == node.total)
+                    continue;
+                node.total = total;
+                for (int j : outgoing[group[k]]) {
+                    if (message_nodes[j].jitter == total)
+                        continue;
+                    message_nodes[j].jitter = total;
+                    markFrom(message_nodes, buses, message_rank, j);
+                    changed = true;
+                }
+            }
+        }
+
+        // Message phase
+        for (const auto& group : buses) {
+            for (int k = 0; k < static_cast<int>(group.size()); ++k) {
+                Node& node = message_nodes[group[k]];
+                if (!node.dirty)
+                    continue;
+                node.dirty = false;
+                ++result.recomputations;
+                node.window = messageWindow(message_nodes, group, k, limit);
+                double total = node.jitter + node.window;
+                if (total == node.total)
+                    continue;
+                node.total = total;
+                int dst = message_destination[group[k]];
+                if (dst < 0)
+                    continue;
+                double jitter = 0;
+                for (int j : incoming[dst])
+                    jitter = std::max(jitter, message_nodes[j].total);
+                if (jitter == task_nodes[dst].jitter)
+                    continue;
+                task_nodes[dst].jitter = jitter;
+                markFrom(task_nodes, processors, task_rank, dst);
+                changed = true;
+            }
+        }
+
+    }
+
+    // Out of iterations: whatever was still waiting for recomputation, and
+    // everything depending on it, has no bound
+    if (changed) {
+        std::vector<int> task_queue, message_queue;
+        auto unboundTask = [&](int i) {
+            if (!std::isinf(task_nodes[i].total) || task_nodes[i].dirty) {
+                task_nodes[i].total = kUnbounded;
+                task_nodes[i].dirty = false;
+                task_queue.push_back(i);
+            }
+        };
+        auto unboundMessage = [&](int j) {
+            if (!std::isinf(message_nodes[j].total) || message_nodes[j].dirty) {
+                message_nodes[j].total = kUnbounded;
+                message_nodes[j].dirty = false;
+                message_queue.push_back(j);
+            }
+        };
+        for (int i = 0; i < n; ++i)
+            if (task_nodes[i].dirty)
+                unboundTask(i);
+        for (int j = 0; j < m; ++j)
+            if (message_nodes[j].dirty)
+                unboundMessage(j);
+        while (!task_queue.empty() || !message_queue.empty()) {
+            if (!task_queue.empty()) {
+                int i = task_queue.back();
+                task_queue.pop_back();
+                const std::vector<int>& group = processors[task_nodes[i].resource];
+                for (int k = task_rank[i] + 1; k < static_cast<int>(group.size()); ++k)
+                    unboundTask(group[k]);
+                for (int j : outgoing[i])
+                    unboundMessage(j);
+            } else {
+                int j = message_queue.back();
+                message_queue.pop_back();
+                const std::vector<int>& group = buses[message_nodes[j].resource];
+                for (int k = message_rank[j] + 1; k < static_cast<int>(group.size()); ++k)
+                    unboundMessage(group[k]);
+                if (message_destination[j] >= 0)
+                    unboundTask(message_destination[j]);
+            }
+        }
+    }
+    for (const auto& node : task_nodes)
+        if (std::isinf(node.total))
+            result.converged = false;
+    for (const auto& node : message_nodes)
+        if (std::isinf(node.total))
+            result.converged = false;
+
+    result.task_response.resize(n);
+    for (int i = 0; i < n; ++i)
+        result.task_response[i] = task_nodes[i].total;
+    result.message_response.resize(m);
+    for (int j = 0; j < m; ++j)
+        result.message_response[j] = message_nodes[j].total;
+
+    result.chains.reserve(m);
+    for (int j = 0; j < m; ++j) {
+        int dst = message_destination[j];
+        double latency = message_nodes[j].total + (dst >= 0 ? task_nodes[dst].window : 0);
+        result.chains.push_back({messages[j].id, messages[j].source, messages[j].destination, latency, !std::isinf(latency)});
+    }
+    return result;
+}
+
+inline void displayHolistic(const HolisticResult& result) {
+    using std::cout;
+    cout << "\nHolistic analysis (" << (result.converged ? "converged" : "diverged") << " after "
+         << result.iterations << " iterations, " << result.recomputations << " recomputations)\n";
+    for (const auto& chain : result.chains) {
+        cout << "Message " << chain.message << " chain Stage " << chain.source << " -> Stage " << chain.destination
+             << " - End-to-end latency: ";
+        if (chain.bounded)
+            cout << chain.latency << "\n";
+        else
+            cout << "unbounded\n";
+    }
+    cout << std::flush;
+}
+
+#endif // HOLISTIC_ANALYSIS_H
@@ -0,0 +1,95 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <future>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "Scheduling_engine.h"
+#include "Holistic_analysis.h"
+
+using namespace std;
+
+// Regression cases for holisticAnalysis(). Each case runs on its own thread
+// under a time limit, since the failures being guarded against are fixed-point
+// loops that never terminate. Exits nonzero if any case fails.
+//
+// Usage: Holistic_analysis_check
+
+const chrono::seconds TIME_LIMIT(5);
+
+struct CheckCase {
+    string name;
+    vector<PeriodicTask> tasks;
+    int num_processors;
+    vector<Message> messages;
+    int num_buses;
+    bool (*expect)(const HolisticResult&);
+};
+
+// Task 1 overloads the processor (C = 2 > T = 1), so task 2 and both of its
+// messages to stage 3, which has no task, are unbounded. The zero-cost message
+// sits ahead of the other one on bus 0; its infinite jitter times zero cost
+// used to make the lower message's window NaN, which never compares as
+// converged, and the analysis never returned.
+CheckCase zeroCostUnboundedInterference() {
+    CheckCase c;
+    c.name = "zero-cost message with unbounded jitter";
+    c.tasks = {
+        {1, 1, 1, {2}, 0, 1, 0, 0, 0},
+        {2, 10, 10, {1}, 0, 10, 0, 0, 0},
+    };
+    c.num_processors = 1;
+    c.messages = {
+        {1, 2, 3, 0, 0, 0, 0}, // Zero cost
+        {2, 2, 3, 1, 0, 1, 0},
+    };
+    c.num_buses = 1;
+    c.expect = [](const HolisticResult& result) {
+        return !result.converged && result.task_response[0] == 2 && isinf(result.task_response[1]) &&
+               isinf(result.message_response[0]) && isinf(result.message_response[1]);
+    };
+    return c;
+}
+
+// A zero-cost higher priority message with finite jitter adds no interference
+CheckCase zeroCostBoundedInterference() {
+    CheckCase c;
+    c.name = "zero-cost message with bounded jitter";
+    c.tasks = {
+        {1, 5, 5, {1}, 0, 5, 0, 0, 0},
+        {2, 10, 10, {1}, 0, 10, 0, 0, 0},
+    };
+    c.num_processors = 1;
+    c.messages = {
+        {1, 1, 3, 0, 0, 0, 0}, // Zero cost
+        {2, 2, 3, 2, 0, 2, 0},
+    };
+    c.num_buses = 1;
+    c.expect = [](const HolisticResult& result) {
+        return result.converged && result.task_response[1] == 2 && result.message_response[1] == 4;
+    };
+    return c;
+}
+
+int main() {
+    vector<CheckCase> cases = {zeroCostUnboundedInterference(), zeroCostBoundedInterference()};
+    int failures = 0;
+    for (const CheckCase& c : cases) {
+        // The task is left running on timeout; the process exits right after
+        auto run = make_shared<packaged_task<HolisticResult()>>([c]() {
+            return holisticAnalysis(c.tasks, c.num_processors, c.messages, c.num_buses);
+        });
+        future<HolisticResult> result = run->get_future();
+        thread([run]() { (*run)(); }).detach();
+        if (result.wait_for(TIME_LIMIT) != future_status::ready) {
+            cout << "FAIL " << c.name << ": no result within " << TIME_LIMIT.count() << " s\n" << flush;
+            _Exit(1);
+        }
+        bool passed = c.expect(result.get());
+        cout << (passed ? "PASS " : "FAIL ") << c.name << "\n";
+        failures += !passed;
+    }
+    return failures ? 1 : 0;
+}
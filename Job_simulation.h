@@ -0,0 +1,380 @@
+#ifndef JOB_SIMULATION_H
+#define JOB_SIMULATION_H
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <queue>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <limits>
+#include <algorithm>
+#include <functional>
+
+#include "Scheduling_engine.h"
+#include "Schedulability_analysis.h"
+
+// Job-level, preemptive fixed-priority simulation of partitioned periodic
+// tasks over the hyperperiod.
+//
+// Time is kept in integer ticks (time_scale ticks per time unit) so the
+// hyperperiod is an exact LCM. Each processor is simulated on its own: a
+// min-heap holds the pending release events, and the ready queue is a min-heap
+// of task priorities, so the job on top always runs and a higher priority
+// release preempts it. The running job's completion is the only other event
+// and is derived from its remaining execution time.
+
+typedef std::int64_t Tick;
+
+// Timing parameters of one task in ticks, on its assigned processor
+struct SimTask {
+    int id;
+    Tick wcet;
+    Tick period;
+    Tick deadline;
+    Tick offset; // First release
+};
+
+// Per-task job statistics over the simulated horizon
+struct JobStats {
+    int id;
+    long long released;
+    long long completed;
+    long long deadline_misses; // Late completions plus jobs past their deadline at the end
+    long long preemptions;
+    Tick max_response;
+    double total_response; // Sum over completed jobs
+    long long dropped_arrivals; // Message arrivals discarded from a full input queue
+    std::vector<long long> dropped_by_input; // The same per input of a triggered task
+};
+
+struct SimulationResult {
+    std::string title;
+    Tick horizon; // Hyperperiod, or the cap if it was reached first
+    bool truncated; // The cap was reached before the hyperperiod
+    double time_scale;
+    long long events; // Releases plus completions
+    long long dropped_arrivals; // Over every task; nonzero means messages were lost
+    std::vector<std::vector<JobStats>> processors; // Per processor, in priority order
+};
+
+inline Tick toTicks(double time, double time_scale) {
+    return static_cast<Tick>(std::llround(time * time_scale));
+}
+
+inline Tick gcdTicks(Tick a, Tick b) {
+    while (b != 0) {
+        Tick temp = b;
+        b = a % b;
+        a = temp;
+    }
+    return a;
+}
+
+// LCM of the task periods, saturating at cap
+// Default cap on the simulated horizon, in time units. Coprime periods make
+// the hyperperiod grow as their product, so runs stop here and say so.
+const double kDefaultMaxHorizon = 1e5;
+
+inline Tick hyperperiod(const std::vector<SimTask>& tasks, Tick cap, bool* truncated = nullptr) {
+    Tick h = 1;
+    bool capped = false;
+    for (const auto& task : tasks) {
+        Tick step = task.period / gcdTicks(h, task.period);
+        if (h > cap / step) {
+            capped = true;
+            break;
+        }
+        h *= step;
+    }
+    if (h > cap)
+        capped = true;
+    if (truncated)
+        *truncated = capped;
+    return capped ? cap : h;
+}
+
+inline std::vector<SimTask> toSimTasks(const std::vector<TaskTiming>& tasks, double time_scale) {
+    std::vector<SimTask> result;
+    result.reserve(tasks.size());
+    for (const auto& task : tasks)
+        result.push_back({task.id, toTicks(task.wcet, time_scale), std::max<Tick>(1, toTicks(task.period, time_scale)),
+                          toTicks(task.deadline, time_scale), 0});
+    return result;
+}
+
+const Tick kNever = std::numeric_limits<Tick>::max();
+const std::size_t kInputCapacity = 64;
+
+// Simulator for one processor; tasks are in decreasing priority order.
+//
+// Periodic tasks release themselves until horizon. A triggered task instead
+// releases a job once every one of its inputs has delivered an arrival, at the
+// latest of those arrival times but no sooner than one period after its
+// previous release: the period acts as a minimum inter-arrival time. Like
+// periodic jobs, only releases before horizon happen. Links from a source task's completions feed
+// those inputs, either directly for tasks on the same processor or through the
+// outbox for other processors. advance() processes every event strictly
+// before a bound, so a caller can interleave it with deliveries from other
+// processors as long as no arrival is delivered earlier than the bound
+// already reached.
+//
+// Inputs fed at different rates would queue arrivals without bound, so each
+// input holds at most kInputCapacity arrivals; beyond that the oldest one is
+// discarded and counted per input in JobStats::dropped_by_input.
+class ProcessorSimulator {
+public:
+    // A send to another processor: link index and the source job's completion time
+    struct Send {
+        int link;
+        Tick time;
+    };
+
+    ProcessorSimulator(const std::vector<SimTask>& tasks, Tick horizon)
+        : tasks_(tasks), horizon_(horizon), n_(static_cast<int>(tasks.size())), stats_(n_), pending_(n_),
+          remaining_(n_, 0), inputs_(n_), last_trigger_(n_, -1), armed_(n_, 0), local_links_(n_), remote_links_(n_), now_(0), running_(-1),
+          events_(0), started_(false) {
+        for (int i = 0; i < n_; ++i)
+            stats_[i] = {tasks_[i].id, 0, 0, 0, 0, 0, 0, 0, {}};
+    }
+
+    // Make a task release on arrivals at `inputs` inputs instead of periodically
+    void setTriggered(int task, int inputs) {
+        inputs_[task].assign(inputs, std::deque<Tick>());
+        stats_[task].dropped_by_input.assign(inputs, 0);
+    }
+    // Completions of source feed input `input` of destination on this processor after delay
+    void addLocalLink(int source, int destination, int input, Tick delay) {
+        local_links_[source].push_back({destination, input, delay});
+    }
+    // Completions of source are reported in the outbox under link
+    void addRemoteLink(int source, int link) { remote_links_[source].push_back(link); }
+
+    // An arrival at input `input` of a triggered task
+    void deliver(int task, int input, Tick arrival) {
+        std::vector<std::deque<Tick>>& queues = inputs_[task];
+        if (queues[input].size() >= kInputCapacity) {
+            queues[input].pop_front();
+            ++stats_[task].dropped_arrivals;
+            ++stats_[task].dropped_by_input[input];
+        }
+        queues[input].push_back(arrival);
+        trigger(task);
+    }
+
+    // Process every event strictly before bound (kNever: run to the end)
+    void advance(Tick bound) {
+        if (!started_) {
+            started_ = true;
+            for (int i = 0; i < n_; ++i)
+                if (inputs_[i].empty() && tasks_[i].offset < horizon_)
+                    releases_.push({tasks_[i].offset, i});
+        }
+
+        while (true) {
+            Tick next_release = releases_.empty() ? kNever : releases_.top().first;
+
+            if (!ready_.empty()) {
+                int task = ready_.top();
+                running_ = task;
+                Tick completion = now_ + remaining_[task];
+                if (completion <= next_release && completion < bound) {
+                    complete(task, completion);
+                    continue;
+                }
+                Tick until = std::min(next_release, bound);
+                if (until == kNever)
+                    return;
+                remaining_[task] -= until - now_;
+                now_ = until;
+            } else {
+                if (next_release >= bound) {
+                    if (bound != kNever)
+                        now_ = std::max(now_, bound);
+                    return;
+                }
+                now_ = next_release;
+            }
+            if (next_release >= bound)
+                return;
+
+            // Release every job due now
+            while (!releases_.empty() && releases_.top().first == now_) {
+                int task = releases_.top().second;
+                releases_.pop();
+                if (pending_[task].empty()) {
+                    remaining_[task] = tasks_[task].wcet;
+                    ready_.push(task);
+                }
+                pending_[task].push_back(now_);
+                ++stats_[task].released;
+                ++events_;
+                if (inputs_[task].empty()) {
+                    Tick next = now_ + tasks_[task].period;
+                    if (next < horizon_)
+                        releases_.push({next, task});
+                } else {
+                    armed_[task] = 0;
+                    trigger(task);
+                }
+            }
+            if (running_ >= 0 && !ready_.empty() && ready_.top() != running_)
+                ++stats_[running_].preemptions;
+        }
+    }
+
+    // No job ready and no release pending; only a delivery can wake it up
+    bool idle() const { return started_ && ready_.empty() && releases_.empty(); }
+    Tick now() const { return now_; }
+    long long events() const { return events_; }
+    std::vector<Send>& outbox() { return outbox_; }
+
+    // Jobs that never got a chance to finish are misses once their deadline is past
+    const std::vector<JobStats>& finish() {
+        for (int i = 0; i < n_; ++i)
+            for (Tick release : pending_[i])
+                if (release + tasks_[i].deadline <= now_)
+                    ++stats_[i].deadline_misses;
+        return stats_;
+    }
+
+private:
+    struct LocalLink {
+        int destination;
+        int input;
+        Tick delay;
+    };
+    typedef std::pair<Tick, int> Release; // (time, task)
+
+    // Schedule the next release of a triggered task once every input has an
+    // arrival. Only one release is scheduled at a time, so arrivals wait in
+    // the bounded input queues rather than as future releases.
+    void trigger(int task) {
+        if (armed_[task])
+            return;
+        std::vector<std::deque<Tick>>& queues = inputs_[task];
+        Tick release = now_;
+        for (const auto& queue : queues) {
+            if (queue.empty())
+                return;
+            release = std::max(release, queue.front());
+        }
+        if (last_trigger_[task] >= 0)
+            release = std::max(release, last_trigger_[task] + tasks_[task].period);
+        if (release >= horizon_)
+            return;
+        for (auto& queue : queues)
+            queue.pop_front();
+        last_trigger_[task] = release;
+        armed_[task] = 1;
+        releases_.push({release, task});
+    }
+
+    void complete(int task, Tick completion) {
+        now_ = completion;
+        Tick release = pending_[task].front();
+        pending_[task].pop_front();
+        Tick response = now_ - release;
+        JobStats& s = stats_[task];
+        ++s.completed;
+        s.total_response += static_cast<double>(response);
+        s.max_response = std::max(s.max_response, response);
+        if (response > tasks_[task].deadline)
+            ++s.deadline_misses;
+        ++events_;
+        if (pending_[task].empty()) {
+            ready_.pop();
+            running_ = -1;
+        } else {
+            remaining_[task] = tasks_[task].wcet;
+        }
+        for (const LocalLink& link : local_links_[task])
+            deliver(link.destination, link.input, now_ + link.delay);
+        for (int link : remote_links_[task])
+            outbox_.push_back({link, now_});
+    }
+
+    const std::vector<SimTask>& tasks_;
+    Tick horizon_;
+    int n_;
+    std::vector<JobStats> stats_;
+    std::priority_queue<Release, std::vector<Release>, std::greater<Release>> releases_;
+    std::priority_queue<int, std::vector<int>, std::greater<int>> ready_; // Task priorities with pending jobs
+    std::vector<std::deque<Tick>> pending_; // Release times of pending jobs, oldest first
+    std::vector<Tick> remaining_; // Remaining execution of each task's oldest job
+    std::vector<std::vector<std::deque<Tick>>> inputs_; // Per triggered task, arrivals per input
+    std::vector<Tick> last_trigger_; // Latest release of each triggered task, -1 before the first
+    std::vector<char> armed_; // A triggered task's next release is scheduled
+    std::vector<std::vector<LocalLink>> local_links_;
+    std::vector<std::vector<int>> remote_links_;
+    std::vector<Send> outbox_;
+    Tick now_;
+    int running_;
+    long long events_;
+    bool started_;
+};
+
+// Simulate one independent processor; tasks are in decreasing priority order.
+// Jobs released before horizon run to completion, and the number of processed
+// events is added to *events.
+inline std::vector<JobStats> simulateProcessor(const std::vector<SimTask>& tasks, Tick horizon, long long* events = nullptr) {
+    ProcessorSimulator simulator(tasks, horizon);
+    simulator.advance(kNever);
+    if (events)
+        *events += simulator.events();
+    return simulator.finish();
+}
+
+// Simulate a partitioned task set over its hyperperiod, capped at max_horizon
+// time units; SimulationResult::truncated tells whether the cap was hit. Tasks must carry the processor and rank set by
+// SchedulingEngine::schedulePeriodicTasks().
+inline SimulationResult simulateHyperperiod(const std::vector<PeriodicTask>& tasks, int num_processors,
+                                            double time_scale = 1000, double max_horizon = kDefaultMaxHorizon) {
+    std::vector<std::vector<TaskTiming>> partitions = partitionByProcessor(tasks, num_processors);
+    std::vector<std::vector<SimTask>> sim(num_processors);
+    std::vector<SimTask> all;
+    for (int p = 0; p < num_processors; ++p) {
+        sim[p] = toSimTasks(partitions[p], time_scale);
+        all.insert(all.end(), sim[p].begin(), sim[p].end());
+    }
+
+    SimulationResult result;
+    result.title = "Hyperperiod simulation";
+    result.time_scale = time_scale;
+    result.horizon = hyperperiod(all, toTicks(max_horizon, time_scale), &result.truncated);
+    result.events = 0;
+    result.dropped_arrivals = 0;
+    result.processors.resize(num_processors);
+    for (int p = 0; p < num_processors; ++p)
+        result.processors[p] = simulateProcessor(sim[p], result.horizon, &result.events);
+    return result;
+}
+
+inline void displaySimulation(const SimulationResult& result) {
+    using std::cout;
+    const double scale = result.time_scale;
+    cout << "\n" << result.title << " (horizon " << result.horizon / scale
+         << (result.truncated ? ", truncated before the hyperperiod" : "") << ", " << result.events << " events";
+    if (result.dropped_arrivals > 0)
+        cout << ", " << result.dropped_arrivals << " message arrivals dropped";
+    cout << ")\n";
+    for (int p = 0; p < static_cast<int>(result.processors.size()); ++p) {
+        for (const auto& s : result.processors[p]) {
+            double average = s.completed ? s.total_response / s.completed / scale : 0;
+            cout << "Task " << s.id << " on Processor " << p + 1 << " - Jobs: " << s.released
+                 << ", Deadline misses: " << s.deadline_misses << ", Preemptions: " << s.preemptions
+                 << ", Response time max: " << s.max_response / scale << ", avg: " << average;
+            if (s.dropped_arrivals > 0) {
+                cout << ", Dropped arrivals: " << s.dropped_arrivals << " (";
+                for (std::size_t k = 0; k < s.dropped_by_input.size(); ++k)
+                    cout << (k ? ", " : "") << "input " << k + 1 << ": " << s.dropped_by_input[k];
+                cout << ")";
+            }
+            cout << "\n";
+        }
+    }
+    cout << std::flush;
+}
+
+#endif // JOB_SIMULATION_H
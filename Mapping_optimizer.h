@@ -0,0 +1,277 @@
+#ifndef MAPPING_OPTIMIZER_H
+#define MAPPING_OPTIMIZER_H
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+// Simulated-annealing improvement of a task-to-processor mapping.
+//
+// The timing model is the one of the list scheduler in Task_scheduling.cpp:
+// tasks are placed in a fixed processing order, each one starts once its
+// processor is free and every predecessor's result has arrived
+// (finish + p_matrix[from][to] * adj[pred][task]), and runs for
+// weight[task][processor]. The order must list every predecessor before its
+// successors; sortPredecessorsFirst() repairs a priority order that does not.
+// Only the mapping changes, so the list schedule is
+// a valid seed and every candidate is a complete schedule. Self edges on the
+// adjacency diagonal are not precedences and are left out, so a seed's
+// makespan can be below the finish times algo() prints.
+//
+// Independent chains run on their own threads within a wall-clock budget;
+// the best mapping found by any chain wins.
+
+struct MappingProblem {
+    int nodes;
+    int processors;
+    std::vector<float> weight; // nodes x processors execution times
+    std::vector<float> link; // processors x processors communication factor (p_matrix)
+    std::vector<std::vector<std::pair<int, float>>> predecessors; // Per task: (predecessor, data volume)
+    std::vector<int> order; // Processing order of the list scheduler
+
+    float execution(int task, int processor) const { return weight[task * processors + processor]; }
+    float communication(int from, int to, float volume) const { return link[from * processors + to] * volume; }
+};
+
+// Reorder problem.order so that every task follows its predecessors, keeping
+// the given order among tasks that are ready together. Returns false and
+// leaves the order unchanged when the precedence graph has a cycle.
+inline bool sortPredecessorsFirst(MappingProblem& problem) {
+    std::vector<int> pending(problem.nodes, 0);
+    std::vector<std::vector<int>> successors(problem.nodes);
+    for (int task = 0; task < problem.nodes; ++task)
+        for (const auto& edge : problem.predecessors[task]) {
+            successors[edge.first].push_back(task);
+            ++pending[task];
+        }
+    std::vector<int> rank(problem.nodes);
+    for (int j = 0; j < problem.nodes; ++j)
+        rank[problem.order[j]] = j;
+    // Min-heap of ready tasks by their position in the given order
+    std::vector<int> ready;
+    auto later = [&](int a, int b) { return rank[a] > rank[b]; };
+    for (int task = 0; task < problem.nodes; ++task)
+        if (pending[task] == 0)
+            ready.push_back(task);
+    std::make_heap(ready.begin(), ready.end(), later);
+    std::vector<int> order;
+    order.reserve(problem.nodes);
+    while (!ready.empty()) {
+        std::pop_heap(ready.begin(), ready.end(), later);
+        int task = ready.back();
+        ready.pop_back();
+        order.push_back(task);
+        for (int successor : successors[task])
+            if (--pending[successor] == 0) {
+                ready.push_back(successor);
+                std::push_heap(ready.begin(), ready.end(), later);
+            }
+    }
+    if (static_cast<int>(order.size()) != problem.nodes)
+        return false;
+    problem.order.swap(order);
+    return true;
+}
+
+// Makespan of a mapping, re-timed incrementally after single-task moves.
+//
+// For every position in the processing order the evaluator keeps the time
+// each processor becomes free before that position. Moving a task re-times
+// it and then only the later tasks whose processor availability or
+// predecessor finish times changed; the sweep stops as soon as no processor
+// differs from the previous schedule and no changed task has successors left.
+class MappingEvaluator {
+public:
+    MappingEvaluator(const MappingProblem& problem, const std::vector<int>& assignment)
+        : problem_(problem), n_(problem.nodes), p_(problem.processors), assignment_(assignment), finish_(n_, 0),
+          position_(n_, 0), last_successor_(n_, -1), free_((n_ + 1) * p_, 0), changed_(n_, 0) {
+        for (int j = 0; j < n_; ++j)
+            position_[problem_.order[j]] = j;
+        for (int task = 0; task < n_; ++task)
+            for (const auto& edge : problem_.predecessors[task])
+                last_successor_[edge.first] = std::max(last_successor_[edge.first], position_[task]);
+        retime(0, -1);
+    }
+
+    float makespan() const {
+        const float* end = &free_[n_ * p_];
+        return n_ > 0 ? *std::max_element(end, end + p_) : 0;
+    }
+    const std::vector<int>& assignment() const { return assignment_; }
+    float finish(int task) const { return finish_[task]; }
+    float start(int task) const { return finish_[task] - problem_.execution(task, assignment_[task]); }
+
+    // Reassign one task and return the new makespan
+    float move(int task, int processor) {
+        if (assignment_[task] != processor) {
+            assignment_[task] = processor;
+            retime(position_[task], task);
+        }
+        return makespan();
+    }
+
+private:
+    float startTime(int task, int processor, const float* free) const {
+        float ready = free[processor];
+        for (const auto& edge : problem_.predecessors[task])
+            ready = std::max(ready, finish_[edge.first] + problem_.communication(assignment_[edge.first], processor, edge.second));
+        return ready;
+    }
+
+    // Re-time from position `from`; moved is the reassigned task (-1 for a full pass)
+    void retime(int from, int moved) {
+        std::vector<float> free(free_.begin() + from * p_, free_.begin() + (from + 1) * p_);
+        int diverged = 0; // Processors whose availability differs from the stored schedule
+        int reach = -1; // Last position fed by a changed task
+        int j = from;
+        for (; j < n_; ++j) {
+            if (moved >= 0 && j > from && diverged == 0 && j > reach)
+                break; // Everything from here on is unchanged
+            float* stored = &free_[j * p_];
+
+            int task = problem_.order[j];
+            int processor = assignment_[task];
+            bool dirty = moved < 0 || task == moved || free[processor] != stored[processor];
+            if (!dirty)
+                for (const auto& edge : problem_.predecessors[task])
+                    if (changed_[edge.first]) {
+                        dirty = true;
+                        break;
+                    }
+            if (dirty) {
+                float finish = startTime(task, processor, free.data()) + problem_.execution(task, processor);
+                // A moved task changes its successors' communication costs too
+                if (finish != finish_[task] || task == moved) {
+                    finish_[task] = finish;
+                    changed_[task] = 1;
+                    reach = std::max(reach, last_successor_[task]);
+                }
+            }
+            std::copy(free.begin(), free.end(), stored);
+            free[processor] = finish_[task];
+
+            diverged = 0;
+            const float* next = stored + p_;
+            for (int q = 0; q < p_; ++q)
+                if (free[q] != next[q])
+                    ++diverged;
+        }
+        if (j == n_)
+            std::copy(free.begin(), free.end(), free_.begin() + n_ * p_);
+        for (int k = from; k < j; ++k)
+            changed_[problem_.order[k]] = 0;
+    }
+
+    const MappingProblem& problem_;
+    int n_;
+    int p_;
+    std::vector<int> assignment_;
+    std::vector<float> finish_;
+    std::vector<int> position_;
+    std::vector<int> last_successor_; // Position of the last successor of each task
+    std::vector<float> free_; // (nodes + 1) x processors: availability before each position
+    std::vector<char> changed_; // Finish time changed during the current sweep
+};
+
+struct MappingResult {
+    std::vector<int> assignment;
+    float seed_makespan;
+    float makespan;
+    long long evaluations; // Moves evaluated over all chains
+    int chains;
+};
+
+// One annealing chain: random single-task moves, geometric cooling over the
+// time budget, best mapping kept
+inline MappingResult annealMapping(const MappingProblem& problem, const std::vector<int>& seed,
+                                   std::chrono::steady_clock::time_point deadline, double budget_seconds,
+                                   unsigned random_seed) {
+    MappingEvaluator evaluator(problem, seed);
+    MappingResult best{seed, evaluator.makespan(), evaluator.makespan(), 0, 1};
+    if (problem.nodes == 0 || problem.processors < 2)
+        return best;
+
+    std::mt19937 random(random_seed);
+    std::uniform_int_distribution<int> pick_task(0, problem.nodes - 1);
+    std::uniform_int_distribution<int> pick_processor(0, problem.processors - 2);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    const double initial_temperature = 0.1 * std::max(1e-6f, best.seed_makespan);
+    const double final_temperature = 1e-3 * initial_temperature;
+    double temperature = initial_temperature;
+    float current = best.makespan;
+
+    for (long long iteration = 0;; ++iteration) {
+        if ((iteration & 255) == 0) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline)
+                break;
+            double left = std::chrono::duration<double>(deadline - now).count() / budget_seconds;
+            temperature = initial_temperature * std::pow(final_temperature / initial_temperature, 1.0 - left);
+        }
+
+        int task = pick_task(random);
+        int old_processor = evaluator.assignment()[task];
+        int processor = pick_processor(random);
+        if (processor >= old_processor)
+            ++processor;
+
+        float candidate = evaluator.move(task, processor);
+        ++best.evaluations;
+        if (candidate <= current || unit(random) < std::exp((current - candidate) / temperature)) {
+            current = candidate;
+            if (candidate < best.makespan) {
+                best.makespan = candidate;
+                best.assignment = evaluator.assignment();
+            }
+        } else {
+            evaluator.move(task, old_processor);
+        }
+    }
+    return best;
+}
+
+// Improve the seed mapping with `chains` independent annealing chains for
+// budget_ms milliseconds of wall-clock time
+inline MappingResult optimizeMapping(const MappingProblem& problem, const std::vector<int>& seed, double budget_ms = 50,
+                                     unsigned chains = std::thread::hardware_concurrency(), unsigned random_seed = 1) {
+    chains = std::max(1u, chains);
+    const double budget_seconds = std::max(1e-3, budget_ms / 1000.0);
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(budget_seconds));
+
+    std::vector<MappingResult> results(chains);
+    std::vector<std::thread> threads;
+    for (unsigned c = 1; c < chains; ++c)
+        threads.emplace_back([&, c]() { results[c] = annealMapping(problem, seed, deadline, budget_seconds, random_seed + c); });
+    results[0] = annealMapping(problem, seed, deadline, budget_seconds, random_seed);
+    for (auto& thread : threads)
+        thread.join();
+
+    MappingResult best = results[0];
+    for (unsigned c = 1; c < chains; ++c) {
+        best.evaluations += results[c].evaluations;
+        if (results[c].makespan < best.makespan) {
+            best.makespan = results[c].makespan;
+            best.assignment = results[c].assignment;
+        }
+    }
+    best.chains = static_cast<int>(chains);
+    return best;
+}
+
+inline void displayMapping(const MappingProblem& problem, const MappingResult& result) {
+    using std::cout;
+    MappingEvaluator evaluator(problem, result.assignment);
+    cout << "\nAnnealed mapping (" << result.chains << " chains, " << result.evaluations << " moves evaluated)\n";
+    cout << "Makespan: " << result.seed_makespan << " -> " << result.makespan << "\n";
+    for (int task = 0; task < problem.nodes; ++task)
+        cout << "Task " << task + 1 << " with EFT " << evaluator.finish(task) << " on Processor " << result.assignment[task] + 1 << "\n";
+    cout << std::flush;
+}
+
+#endif // MAPPING_OPTIMIZER_H
@@ -1,103 +1,12 @@
 #include <iostream>
 #include <vector>
-#include <algorithm>
-#include <numeric>
-#include <cmath>
 #include <unordered_map>
 #include <set>
 
-using namespace std;
-
-// Signal structure
-struct Signal {
-    int id;                 // Signal ID
-    int size;               // Signal size in bytes
-    int period;             // Periodicity of the signal in milliseconds
-
-    Signal(int i, int s, int p) : id(i), size(s), period(p) {}
-};
-
-// Function to calculate the greatest common divisor (GCD)
-int gcd(int a, int b) {
-    while (b != 0) {
-        int temp = b;
-        b = a % b;
-        a = temp;
-    }
-    return a;
-}
-
-// Function to check if two numbers are coprime
-bool isCoprime(int a, int b) {
-    return gcd(a, b) == 1;
-}
-
-// Function to calculate the number of coprime periodicities
-int countCoprimePeriodicities(const vector<int> &periods) {
-    int count = 0;
-    for (size_t i = 0; i < periods.size(); ++i) {
-        for (size_t j = i + 1; j < periods.size(); ++j) {
-            if (isCoprime(periods[i], periods[j])) {
-                count++;
-            }
-        }
-    }
-    return count;
-}
-
-// Function to find the final minimum number of slots
-int findMinSlots(int Tc, int max_sl_s, const vector<int> &periods) {
-    // Step 3: Determine the maximum slot size (max aggregate message size)
-    int min_sl_s2 = Tc / max_sl_s;
-
-    // Step 4: Minimum number of slots = sum of co-prime periodicities
-    int min_slots = countCoprimePeriodicities(periods);
-
-    // Step 5: Final minimum number of slots
-    return max(min_sl_s2, min_slots);
-}
-
-// Function to find the final optimal slot size
-int findOptimalSlotSize(const vector<Signal> &signals, int Tc, int max_sl_s) {
-    // Step 2: Determine the minimum slot size (max signal size)
-    int min_sl_s1 = 0;
-    for (const Signal &signal : signals) {
-        min_sl_s1 = max(min_sl_s1, signal.size);
-    }
-
-    // Step 6: Find optimal slot size
-    int min_slots = findMinSlots(Tc, max_sl_s, {signals[0].period});
-    int max_slots = Tc / min_sl_s1;
-    int optimal_slot_size = 0;
-    int max_utilization = 0;
-
-    for (int k = min_slots; k <= max_slots; ++k) {
-        // Combine signals into message bins for each periodicity
-        unordered_map<int, vector<Signal>> message_bins; // Message bins keyed by periodicity
-        for (const Signal &signal : signals) {
-            if (k * signal.size <= Tc && k >= signal.size) {
-                message_bins[signal.period].push_back(signal);
-            }
-        }
-
-        // Combine signals within each message bin to minimize empty space
-        // This is a simplified implementation, more complex algorithms can be used for better optimization
-        int total_utilization = 0;
-        for (const auto &bin : message_bins) {
-            int total_size = accumulate(bin.second.begin(), bin.second.end(), 0, [](int sum, const Signal &signal) { return sum + signal.size; });
-            int utilization = ceil((double)total_size / k);
-            total_utilization += utilization;
-        }
+#include "Message_framing.h"
+#include "Sensitivity_analysis.h"
 
-        // Update optimal slot size based on maximum utilization
-        if (total_utilization > max_utilization) {
-            optimal_slot_size = Tc / k;
-            max_utilization = total_utilization;
-        }
-    }
-
-    return optimal_slot_size;
-}
+using namespace std;
 
 // Function to display the final message sets
 void displayMessageSets(const vector<Signal> &signals, int optimal_slot_size) {
@@ -138,24 +47,11 @@ int main() {
     };
 
     // Step 1: Calculate the Total cycle length (Tc)
-    vector<int> periods;
-    for (const Signal &signal : signals) {
-        periods.push_back(signal.period);
-    }
-    int Tc = accumulate(periods.begin(), periods.end(), periods[0], gcd);
+    int Tc = totalCycleLength(signals);
     cout << "Total cycle length (Tc): " << Tc << " milliseconds" << endl;
 
     // Step 3: Determine the maximum slot size (max aggregate message size)
-    int max_sl_s = 0;
-    for (int i = 1; i <= Tc; ++i) {
-        int aggregate_size = 0;
-        for (const Signal &signal : signals) {
-            if (i % signal.period == 0) {
-                aggregate_size += signal.size;
-            }
-        }
-        max_sl_s = max(max_sl_s, aggregate_size);
-    }
+    int max_sl_s = maxAggregateSlotSize(signals, Tc);
 
     // Step 6: Find final optimal slot size
     int optimal_slot_size = findOptimalSlotSize(signals, Tc, max_sl_s);
@@ -164,6 +60,9 @@ int main() {
     // Step 7: Display final message sets framed by combining signals
     displayMessageSets(signals, optimal_slot_size);
 
+    // How much the signals can grow before they no longer fit
+    displaySignalSensitivity(signalSensitivity(signals, Tc));
+
     return 0;
 }
 
@@ -0,0 +1,139 @@
+#ifndef MESSAGE_FRAMING_H
+#define MESSAGE_FRAMING_H
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <unordered_map>
+#include <limits>
+
+// FlexRay static-segment framing: pack periodic signals into equal-size
+// messages. Used by Message_framing.cpp and the tools built around it.
+
+// Signal structure
+struct Signal {
+    int id;                 // Signal ID
+    int size;               // Signal size in bytes
+    int period;             // Periodicity of the signal in milliseconds
+
+    Signal(int i, int s, int p) : id(i), size(s), period(p) {}
+};
+
+// Function to calculate the greatest common divisor (GCD)
+inline int gcd(int a, int b) {
+    while (b != 0) {
+        int temp = b;
+        b = a % b;
+        a = temp;
+    }
+    return a;
+}
+
+// Function to check if two numbers are coprime
+inline bool isCoprime(int a, int b) {
+    return gcd(a, b) == 1;
+}
+
+// Function to calculate the number of coprime periodicities
+// Pairs are counted per distinct period, so large signal sets with a handful
+// of periods stay linear
+inline long long countCoprimePeriodicities(const std::vector<int> &periods) {
+    std::unordered_map<int, long long> multiplicity;
+    for (int period : periods) {
+        ++multiplicity[period];
+    }
+    std::vector<std::pair<int, long long>> distinct(multiplicity.begin(), multiplicity.end());
+    long long count = 0;
+    for (size_t i = 0; i < distinct.size(); ++i) {
+        if (isCoprime(distinct[i].first, distinct[i].first)) {
+            count += distinct[i].second * (distinct[i].second - 1) / 2;
+        }
+        for (size_t j = i + 1; j < distinct.size(); ++j) {
+            if (isCoprime(distinct[i].first, distinct[j].first)) {
+                count += distinct[i].second * distinct[j].second;
+            }
+        }
+    }
+    return count;
+}
+
+// Function to find the final minimum number of slots
+inline int findMinSlots(int Tc, int max_sl_s, const std::vector<int> &periods) {
+    // Step 3: Determine the maximum slot size (max aggregate message size)
+    int min_sl_s2 = max_sl_s > 0 ? Tc / max_sl_s : 0;
+
+    // Step 4: Minimum number of slots = sum of co-prime periodicities
+    long long min_slots = countCoprimePeriodicities(periods);
+
+    // Step 5: Final minimum number of slots
+    return static_cast<int>(std::min<long long>(std::max<long long>(min_sl_s2, min_slots), std::numeric_limits<int>::max()));
+}
+
+// Function to find the final optimal slot size
+inline int findOptimalSlotSize(const std::vector<Signal> &signals, int Tc, int max_sl_s) {
+    // Step 2: Determine the minimum slot size (max signal size)
+    int min_sl_s1 = 0;
+    for (const Signal &signal : signals) {
+        min_sl_s1 = std::max(min_sl_s1, signal.size);
+    }
+
+    // Step 6: Find optimal slot size
+    int min_slots = findMinSlots(Tc, max_sl_s, {signals[0].period});
+    int max_slots = Tc / min_sl_s1;
+    int optimal_slot_size = 0;
+    int max_utilization = 0;
+
+    for (int k = min_slots; k <= max_slots; ++k) {
+        // Combine signals into message bins for each periodicity
+        std::unordered_map<int, std::vector<Signal>> message_bins; // Message bins keyed by periodicity
+        for (const Signal &signal : signals) {
+            if (k * signal.size <= Tc && k >= signal.size) {
+                message_bins[signal.period].push_back(signal);
+            }
+        }
+
+        // Combine signals within each message bin to minimize empty space
+        // This is a simplified implementation, more complex algorithms can be used for better optimization
+        int total_utilization = 0;
+        for (const auto &bin : message_bins) {
+            int total_size = std::accumulate(bin.second.begin(), bin.second.end(), 0, [](int sum, const Signal &signal) { return sum + signal.size; });
+            int utilization = std::ceil((double)total_size / k);
+            total_utilization += utilization;
+        }
+
+        // Update optimal slot size based on maximum utilization
+        if (total_utilization > max_utilization) {
+            optimal_slot_size = Tc / k;
+            max_utilization = total_utilization;
+        }
+    }
+
+    return optimal_slot_size;
+}
+
+// Step 1: Total cycle length (Tc), the GCD of the signal periods
+inline int totalCycleLength(const std::vector<Signal> &signals) {
+    int Tc = signals[0].period;
+    for (const Signal &signal : signals) {
+        Tc = gcd(Tc, signal.period);
+    }
+    return Tc;
+}
+
+// Step 3: Maximum slot size, the largest aggregate size released at one instant of the cycle
+inline int maxAggregateSlotSize(const std::vector<Signal> &signals, int Tc) {
+    int max_sl_s = 0;
+    for (int i = 1; i <= Tc; ++i) {
+        int aggregate_size = 0;
+        for (const Signal &signal : signals) {
+            if (i % signal.period == 0) {
+                aggregate_size += signal.size;
+            }
+        }
+        max_sl_s = std::max(max_sl_s, aggregate_size);
+    }
+    return max_sl_s;
+}
+
+#endif // MESSAGE_FRAMING_H
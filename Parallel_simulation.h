@@ -0,0 +1,285 @@
+#ifndef PARALLEL_SIMULATION_H
+#define PARALLEL_SIMULATION_H
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+#include "Scheduling_engine.h"
+#include "Schedulability_analysis.h"
+#include "Job_simulation.h"
+
+// Parallel job-level simulation of a partitioned task set coupled by messages.
+//
+// Every processor is a logical process with its own ProcessorSimulator and
+// runs on its own thread. A message from a task on processor P to a task on
+// processor Q makes the destination task triggered: a job is released each
+// time every one of its inputs has delivered an arrival (source completion +
+// transmission time), and the task's own period only acts as a minimum
+// inter-arrival time between those releases. A destination therefore runs at
+// the slower of its sources' rate and its own, which is why the result is
+// titled "Message-triggered simulation" rather than compared job for job with
+// simulateHyperperiod(). Arrivals that pile up beyond the input capacity are
+// dropped and reported in SimulationResult::dropped_arrivals and per input in
+// JobStats, numbered in message order.
+//
+// Synchronisation is conservative, in the Chandy-Misra-Bryant style but with
+// clocks published through shared memory instead of null messages. Processor P
+// publishes the time up to which it has processed every event; it cannot send
+// anything stamped earlier, so Q may safely process events before
+// clock(P) + lookahead(P -> Q), where the lookahead is the smallest
+// transmission time on that link. Processors with no incoming messages run to
+// the end without ever waiting. Cyclic couplings leapfrog by the lookahead and
+// stop once every processor is idle with no message in flight.
+
+namespace parallel_detail {
+
+// Message coupling between two processors
+struct RemoteLink {
+    int to; // Destination processor
+    int task; // Destination task, index on its processor
+    int input; // Input of the destination task
+    Tick delay; // Transmission time, at least one tick
+};
+
+struct Arrival {
+    int task;
+    int input;
+    Tick time;
+};
+
+struct LogicalProcess {
+    LogicalProcess(const std::vector<SimTask>& tasks, Tick horizon)
+        : simulator(tasks, horizon), clock(0), idle(false), finished(false) {}
+
+    ProcessorSimulator simulator;
+    std::vector<std::pair<int, Tick>> predecessors; // (processor, lookahead)
+    std::vector<std::vector<Arrival>> staged; // Outgoing arrivals per destination processor
+    std::mutex inbox_mutex;
+    std::vector<Arrival> inbox;
+    std::atomic<Tick> clock; // Every event before this time has been processed
+    std::atomic<bool> idle; // Nothing to do until a message arrives
+    bool finished; // Clock reached kNever; touched only by the owning thread
+};
+
+class Coordinator {
+public:
+    Coordinator(std::vector<std::unique_ptr<LogicalProcess>>& processes, const std::vector<RemoteLink>& links)
+        : processes_(processes), links_(links), in_flight_(0), activity_(0), done_(false) {}
+
+    bool done() const { return done_.load(); }
+
+    // One round of processor q: read predecessor clocks, take delivered
+    // arrivals, advance to the safe bound, send, publish the new clock.
+    // Returns whether anything moved.
+    bool step(int q) {
+        LogicalProcess& lp = *processes_[q];
+        if (lp.finished)
+            return false;
+
+        Tick bound = kNever;
+        for (const auto& predecessor : lp.predecessors) {
+            Tick clock = processes_[predecessor.first]->clock.load();
+            if (clock != kNever)
+                bound = std::min(bound, clock + predecessor.second);
+        }
+
+        bool progressed = false;
+        std::vector<Arrival> arrivals;
+        {
+            std::lock_guard<std::mutex> lock(lp.inbox_mutex);
+            arrivals.swap(lp.inbox);
+        }
+        if (!arrivals.empty()) {
+            // Leave the idle state before the messages stop counting as in flight
+            lp.idle.store(false);
+            activity_.fetch_add(1);
+            for (const Arrival& arrival : arrivals)
+                lp.simulator.deliver(arrival.task, arrival.input, arrival.time);
+            in_flight_.fetch_sub(static_cast<long long>(arrivals.size()));
+            progressed = true;
+        }
+
+        Tick before_now = lp.simulator.now();
+        long long before_events = lp.simulator.events();
+        lp.simulator.advance(bound);
+        progressed = progressed || lp.simulator.now() != before_now || lp.simulator.events() != before_events;
+
+        std::vector<ProcessorSimulator::Send>& outbox = lp.simulator.outbox();
+        if (!outbox.empty()) {
+            for (const auto& send : outbox) {
+                const RemoteLink& link = links_[send.link];
+                lp.staged[link.to].push_back({link.task, link.input, send.time + link.delay});
+            }
+            outbox.clear();
+            for (int r = 0; r < static_cast<int>(lp.staged.size()); ++r) {
+                std::vector<Arrival>& batch = lp.staged[r];
+                if (batch.empty())
+                    continue;
+                in_flight_.fetch_add(static_cast<long long>(batch.size()));
+                LogicalProcess& target = *processes_[r];
+                std::lock_guard<std::mutex> lock(target.inbox_mutex);
+                target.inbox.insert(target.inbox.end(), batch.begin(), batch.end());
+                batch.clear();
+            }
+        }
+
+        if (lp.clock.load() != bound)
+            progressed = true;
+        lp.clock.store(bound);
+        if (bound == kNever) {
+            lp.finished = true;
+            lp.idle.store(true);
+            return true;
+        }
+        if (lp.simulator.idle()) {
+            lp.idle.store(true);
+            checkTermination();
+        }
+        return progressed;
+    }
+
+private:
+    // Everyone idle, nothing in flight, and nobody woke up while we looked
+    void checkTermination() {
+        unsigned long long before = activity_.load();
+        for (const auto& process : processes_)
+            if (!process->idle.load())
+                return;
+        if (in_flight_.load() != 0)
+            return;
+        if (activity_.load() == before)
+            done_.store(true);
+    }
+
+    std::vector<std::unique_ptr<LogicalProcess>>& processes_;
+    const std::vector<RemoteLink>& links_;
+    std::atomic<long long> in_flight_;
+    std::atomic<unsigned long long> activity_;
+    std::atomic<bool> done_;
+};
+
+} // namespace parallel_detail
+
+// Simulate a partitioned, message-coupled task set over the hyperperiod of its
+// tasks, capped at max_horizon time units as in simulateHyperperiod(). Tasks
+// must carry the processor and rank set by
+// SchedulingEngine::schedulePeriodicTasks() and messages the EST/EFT set by
+// scheduleMessages(). With parallel false every processor is stepped in turn
+// on the calling thread, which gives the same result.
+inline SimulationResult simulatePartitioned(const std::vector<PeriodicTask>& tasks, int num_processors,
+                                            const std::vector<Message>& messages, bool parallel = true,
+                                            double time_scale = 1000, double max_horizon = kDefaultMaxHorizon) {
+    using namespace parallel_detail;
+
+    std::vector<std::vector<TaskTiming>> partitions = partitionByProcessor(tasks, num_processors);
+    std::vector<std::vector<SimTask>> sim(num_processors);
+    std::vector<SimTask> all;
+    for (int p = 0; p < num_processors; ++p) {
+        sim[p] = toSimTasks(partitions[p], time_scale);
+        all.insert(all.end(), sim[p].begin(), sim[p].end());
+    }
+
+    SimulationResult result;
+    result.title = "Message-triggered simulation";
+    result.time_scale = time_scale;
+    result.horizon = hyperperiod(all, toTicks(max_horizon, time_scale), &result.truncated);
+    result.events = 0;
+    result.dropped_arrivals = 0;
+    result.processors.resize(num_processors);
+
+    // Stage ID -> (processor, index on processor)
+    int max_id = 0;
+    for (const auto& task : tasks)
+        max_id = std::max(max_id, task.id);
+    std::vector<std::pair<int, int>> location(max_id + 1, std::make_pair(-1, -1));
+    for (int p = 0; p < num_processors; ++p)
+        for (int i = 0; i < static_cast<int>(partitions[p].size()); ++i)
+            if (partitions[p][i].id >= 0)
+                location[partitions[p][i].id] = std::make_pair(p, i);
+    auto locate = [&](int stage) {
+        return (stage >= 0 && stage <= max_id) ? location[stage] : std::make_pair(-1, -1);
+    };
+
+    std::vector<std::unique_ptr<LogicalProcess>> processes;
+    for (int p = 0; p < num_processors; ++p) {
+        processes.emplace_back(new LogicalProcess(sim[p], result.horizon));
+        processes.back()->staged.resize(num_processors);
+    }
+
+    // Inputs per destination task, then the links feeding them
+    std::vector<std::vector<int>> inputs(num_processors);
+    for (int p = 0; p < num_processors; ++p)
+        inputs[p].assign(sim[p].size(), 0);
+    std::vector<int> message_input(messages.size(), -1);
+    for (int j = 0; j < static_cast<int>(messages.size()); ++j) {
+        std::pair<int, int> src = locate(messages[j].source);
+        std::pair<int, int> dst = locate(messages[j].destination);
+        if (src.first < 0 || dst.first < 0 || src == dst)
+            continue;
+        message_input[j] = inputs[dst.first][dst.second]++;
+    }
+    for (int p = 0; p < num_processors; ++p)
+        for (int i = 0; i < static_cast<int>(inputs[p].size()); ++i)
+            if (inputs[p][i] > 0)
+                processes[p]->simulator.setTriggered(i, inputs[p][i]);
+
+    std::vector<RemoteLink> links;
+    std::vector<std::vector<Tick>> lookahead(num_processors, std::vector<Tick>(num_processors, kNever));
+    for (int j = 0; j < static_cast<int>(messages.size()); ++j) {
+        if (message_input[j] < 0)
+            continue;
+        std::pair<int, int> src = locate(messages[j].source);
+        std::pair<int, int> dst = locate(messages[j].destination);
+        Tick delay = std::max<Tick>(1, toTicks(messageCost(messages[j]), time_scale));
+        if (src.first == dst.first) {
+            processes[src.first]->simulator.addLocalLink(src.second, dst.second, message_input[j], delay);
+        } else {
+            processes[src.first]->simulator.addRemoteLink(src.second, static_cast<int>(links.size()));
+            links.push_back({dst.first, dst.second, message_input[j], delay});
+            lookahead[src.first][dst.first] = std::min(lookahead[src.first][dst.first], delay);
+        }
+    }
+    for (int p = 0; p < num_processors; ++p)
+        for (int q = 0; q < num_processors; ++q)
+            if (lookahead[p][q] != kNever)
+                processes[q]->predecessors.push_back({p, lookahead[p][q]});
+
+    Coordinator coordinator(processes, links);
+    if (parallel && num_processors > 1) {
+        std::vector<std::thread> threads;
+        for (int p = 0; p < num_processors; ++p) {
+            threads.emplace_back([&coordinator, &processes, p]() {
+                while (!coordinator.done() && !processes[p]->finished)
+                    if (!coordinator.step(p))
+                        std::this_thread::yield();
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+    } else {
+        bool running = true;
+        while (running && !coordinator.done()) {
+            running = false;
+            for (int p = 0; p < num_processors; ++p) {
+                if (processes[p]->finished)
+                    continue;
+                running = true;
+                coordinator.step(p);
+            }
+        }
+    }
+
+    for (int p = 0; p < num_processors; ++p) {
+        result.events += processes[p]->simulator.events();
+        result.processors[p] = processes[p]->simulator.finish();
+        for (const auto& s : result.processors[p])
+            result.dropped_arrivals += s.dropped_arrivals;
+    }
+    return result;
+}
+
+#endif // PARALLEL_SIMULATION_H
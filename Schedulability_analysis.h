@@ -0,0 +1,168 @@
+#ifndef SCHEDULABILITY_ANALYSIS_H
+#define SCHEDULABILITY_ANALYSIS_H
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "Scheduling_engine.h"
+
+// Fixed-priority schedulability analysis for the rate monotonic schedulers.
+//
+// Utilization bounds (Liu & Layland, hyperbolic) are O(n) sufficient tests
+// used as a fast filter; exact response-time analysis (RTA) only runs when
+// they are inconclusive. Deadlines are assumed constrained (D <= T).
+
+// Timing parameters of one task on the processor it was assigned to
+struct TaskTiming {
+    int id;
+    double wcet;     // Processing time on the assigned processor
+    double period;
+    double deadline;
+};
+
+// Outcome of analysing one processor
+struct ProcessorSchedulability {
+    int processor;
+    double utilization;
+    bool schedulable;
+    std::vector<TaskTiming> tasks;     // In priority order
+    std::vector<double> response_time; // Worst-case response time per task, 0 where not computed
+};
+
+inline double utilization(const std::vector<TaskTiming>& tasks) {
+    double u = 0;
+    for (const auto& task : tasks)
+        u += task.wcet / task.period;
+    return u;
+}
+
+// Liu & Layland: U <= n(2^(1/n) - 1) guarantees RM schedulability
+inline bool liuLaylandTest(const std::vector<TaskTiming>& tasks) {
+    if (tasks.empty())
+        return true;
+    double n = static_cast<double>(tasks.size());
+    return utilization(tasks) <= n * (std::pow(2.0, 1.0 / n) - 1.0);
+}
+
+// Hyperbolic bound (Bini et al.): prod(U_i + 1) <= 2 guarantees RM schedulability
+inline bool hyperbolicTest(const std::vector<TaskTiming>& tasks) {
+    double product = 1;
+    for (const auto& task : tasks) {
+        product *= task.wcet / task.period + 1;
+        if (product > 2)
+            return false;
+    }
+    return true;
+}
+
+// Exact response-time analysis for tasks given in decreasing priority order:
+// R_i = C_i + sum_{j < i} ceil(R_i / T_j) C_j, iterated to a fixed point.
+//
+// Only tasks from `first` on are analysed; response_time must already hold
+// the response times of the tasks before it. An entry from `first` on may hold
+// a lower bound on that task's response time (e.g. from a run with smaller
+// execution times) or 0. Each iteration starts from the larger of that bound
+// and R_{i-1} + C_i, which is also a valid lower bound since task i cannot
+// complete before the higher priority level's busy period plus its own demand.
+// Analysis stops at the first deadline miss; response_time then holds the
+// first demand that exceeded that task's deadline.
+inline bool incrementalResponseTimeAnalysis(const std::vector<TaskTiming>& tasks, std::size_t first,
+                                            std::vector<double>& response_time) {
+    response_time.resize(tasks.size(), 0);
+    double previous = first > 0 ? response_time[first - 1] : 0;
+    for (std::size_t i = first; i < tasks.size(); ++i) {
+        const double c = tasks[i].wcet;
+        const double d = tasks[i].deadline;
+        double r = std::max(previous + c, response_time[i]);
+        while (true) {
+            double demand = c;
+            for (std::size_t j = 0; j < i; ++j)
+                demand += std::ceil(r / tasks[j].period - 1e-9) * tasks[j].wcet;
+            if (demand > d) {
+                response_time[i] = demand;
+                return false;
+            }
+            if (demand <= r)
+                break;
+            r = demand;
+        }
+        response_time[i] = r;
+        previous = r;
+    }
+    return true;
+}
+
+// Full analysis from a cold start; response_time is filled up to and
+// including the first failing task
+inline bool responseTimeAnalysis(const std::vector<TaskTiming>& tasks, std::vector<double>* response_time = nullptr) {
+    std::vector<double> local;
+    std::vector<double>& r = response_time ? *response_time : local;
+    r.assign(tasks.size(), 0);
+    return incrementalResponseTimeAnalysis(tasks, 0, r);
+}
+
+// Utilization filter first, RTA only when the bounds cannot decide
+inline bool isSchedulable(const std::vector<TaskTiming>& tasks, std::vector<double>* response_time = nullptr) {
+    if (utilization(tasks) > 1.0)
+        return false;
+    if (!response_time && hyperbolicTest(tasks))
+        return true;
+    return responseTimeAnalysis(tasks, response_time);
+}
+
+// Split a scheduled task set by assigned processor, each list in priority
+// order. Tasks must carry the processor and rank set by
+// SchedulingEngine::schedulePeriodicTasks().
+inline std::vector<std::vector<TaskTiming>> partitionByProcessor(const std::vector<PeriodicTask>& tasks, int num_processors) {
+    std::vector<const PeriodicTask*> ordered;
+    ordered.reserve(tasks.size());
+    for (const auto& task : tasks)
+        ordered.push_back(&task);
+    std::stable_sort(ordered.begin(), ordered.end(), [](const PeriodicTask* a, const PeriodicTask* b) {
+        return a->rank < b->rank;
+    });
+
+    std::vector<std::vector<TaskTiming>> partitions(num_processors);
+    for (const PeriodicTask* task : ordered) {
+        int p = task->processor;
+        partitions[p].push_back({task->id, task->processing_time[p], task->period, task->deadline});
+    }
+    return partitions;
+}
+
+// Analyse every processor of a partitioned task set
+inline std::vector<ProcessorSchedulability> analyseProcessors(const std::vector<PeriodicTask>& tasks, int num_processors) {
+    std::vector<std::vector<TaskTiming>> partitions = partitionByProcessor(tasks, num_processors);
+    std::vector<ProcessorSchedulability> result(num_processors);
+    for (int p = 0; p < num_processors; ++p) {
+        ProcessorSchedulability& processor = result[p];
+        processor.processor = p;
+        processor.tasks = std::move(partitions[p]);
+        processor.utilization = utilization(processor.tasks);
+        processor.schedulable = processor.utilization <= 1.0 &&
+                                responseTimeAnalysis(processor.tasks, &processor.response_time);
+    }
+    return result;
+}
+
+inline void displaySchedulability(const std::vector<ProcessorSchedulability>& processors) {
+    using std::cout;
+    cout << "\nSchedulability analysis\n";
+    for (const auto& processor : processors) {
+        cout << "Processor " << processor.processor + 1 << " - Utilization: " << processor.utilization
+             << ", Liu&Layland: " << (liuLaylandTest(processor.tasks) ? "pass" : "fail")
+             << ", Hyperbolic: " << (hyperbolicTest(processor.tasks) ? "pass" : "fail")
+             << ", RTA: " << (processor.schedulable ? "schedulable" : "deadline miss") << "\n";
+        for (size_t i = 0; i < processor.tasks.size(); ++i) {
+            if (processor.response_time.empty() || processor.response_time[i] == 0)
+                continue;
+            cout << "Task " << processor.tasks[i].id << " - Response time: " << processor.response_time[i]
+                 << ", Deadline: " << processor.tasks[i].deadline << "\n";
+        }
+    }
+    cout << std::flush;
+}
+
+#endif // SCHEDULABILITY_ANALYSIS_H
@@ -0,0 +1,433 @@
+#ifndef SCHEDULE_EXPORT_H
+#define SCHEDULE_EXPORT_H
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Scheduling_engine.h"
+
+// Schedule results and exporters for downstream tools:
+//   - a compact binary schedule table,
+//   - Chrome trace-event JSON (chrome://tracing, Perfetto) with one track per
+//     processor and bus,
+//   - VCD with one integer signal per processor and bus, holding the ID of the
+//     task or message occupying it (0 when idle).
+// One schedule time unit is a millisecond in both the trace and the VCD.
+// Entries with a non-finite start or finish (unscheduled) are left out of the
+// trace and the VCD, as are zero-length ones from the VCD.
+// All exporters write through BufferedWriter, which formats into a large
+// buffer and issues few write(2) calls, so iostreams are never involved.
+
+// One occupied interval of a processor or bus
+struct ScheduleEntry {
+    enum Kind : std::uint8_t { TaskJob = 0, MessageTransmission = 1 };
+    std::uint8_t kind;
+    std::int32_t resource; // Processor or bus index
+    std::int32_t id; // Task or message ID
+    float start;
+    float finish;
+};
+
+struct ScheduleResult {
+    int num_processors;
+    int num_buses;
+    std::vector<ScheduleEntry> entries;
+};
+
+// Collect the placements made by SchedulingEngine into a schedule result
+inline ScheduleResult buildScheduleResult(const std::vector<PeriodicTask>& tasks, int num_processors,
+                                          const std::vector<Message>& messages, int num_buses) {
+    ScheduleResult result;
+    result.num_processors = num_processors;
+    result.num_buses = num_buses;
+    result.entries.reserve(tasks.size() + messages.size());
+    for (const auto& task : tasks)
+        result.entries.push_back({ScheduleEntry::TaskJob, task.processor, task.id, task.est, task.eft});
+    for (const auto& message : messages)
+        result.entries.push_back({ScheduleEntry::MessageTransmission, message.bus, message.id, message.est, message.eft});
+    return result;
+}
+
+// Write-only file with a large user-space buffer
+class BufferedWriter {
+public:
+    explicit BufferedWriter(const std::string& path, std::size_t buffer_size = 1 << 22)
+        : fd_(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)), buffer_(buffer_size), used_(0) {
+        if (fd_ < 0)
+            throw std::runtime_error("cannot open " + path);
+    }
+    ~BufferedWriter() {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    void write(const void* data, std::size_t size) {
+        if (used_ + size > buffer_.size()) {
+            flush();
+            if (size > buffer_.size()) {
+                writeAll(static_cast<const char*>(data), size);
+                return;
+            }
+        }
+        std::memcpy(&buffer_[used_], data, size);
+        used_ += size;
+    }
+    void put(const char* text) { write(text, std::strlen(text)); }
+    void put(const std::string& text) { write(text.data(), text.size()); }
+    void put(char c) {
+        if (used_ == buffer_.size())
+            flush();
+        buffer_[used_++] = c;
+    }
+
+    void putInt(long long value) {
+        char digits[24];
+        char* end = digits + sizeof(digits);
+        char* p = end;
+        bool negative = value < 0;
+        unsigned long long v = negative ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+        do {
+            *--p = static_cast<char>('0' + v % 10);
+            v /= 10;
+        } while (v);
+        if (negative)
+            *--p = '-';
+        write(p, end - p);
+    }
+
+    // Fixed-point decimal with three fractional digits, trailing zeros trimmed
+    void putFixed(double value) {
+        if (!std::isfinite(value) || std::fabs(value) >= 9e15)
+            throw std::invalid_argument("value cannot be written as fixed point");
+        long long milli = std::llround(value * 1000.0);
+        if (milli < 0) {
+            put('-');
+            milli = -milli;
+        }
+        putInt(milli / 1000);
+        int fraction = static_cast<int>(milli % 1000);
+        if (fraction == 0)
+            return;
+        char digits[4] = {'.', static_cast<char>('0' + fraction / 100), static_cast<char>('0' + fraction / 10 % 10),
+                          static_cast<char>('0' + fraction % 10)};
+        int length = 4;
+        while (digits[length - 1] == '0')
+            --length;
+        write(digits, length);
+    }
+
+    void flush() {
+        writeAll(buffer_.data(), used_);
+        used_ = 0;
+    }
+    void close() {
+        if (fd_ < 0)
+            return;
+        flush();
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+private:
+    void writeAll(const char* data, std::size_t size) {
+        while (size > 0) {
+            ssize_t written = ::write(fd_, data, size);
+            if (written < 0)
+                throw std::runtime_error("write failed");
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+    }
+
+    int fd_;
+    std::vector<char> buffer_;
+    std::size_t used_;
+};
+
+// Binary schedule table, little-endian regardless of the host:
+//   header  "MTPS" | u32 version | u32 num_processors | u32 num_buses | u64 count
+//   records count x { u8 kind | u8 reserved[3] | i32 resource | i32 id | f32 start | f32 finish }
+const std::uint32_t kScheduleFormatVersion = 1;
+
+inline void storeLe32(char* out, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i)
+        out[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+inline void storeLe64(char* out, std::uint64_t value) {
+    for (int i = 0; i < 8; ++i)
+        out[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+inline std::uint32_t loadLe32(const char* in) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+        value |= static_cast<std::uint32_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    return value;
+}
+
+inline std::uint64_t loadLe64(const char* in) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i)
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    return value;
+}
+
+inline std::uint32_t floatBits(float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, 4);
+    return bits;
+}
+
+inline float bitsFloat(std::uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, 4);
+    return value;
+}
+
+inline void writeBinarySchedule(const ScheduleResult& schedule, const std::string& path) {
+    BufferedWriter out(path);
+    char header[24];
+    std::memcpy(header, "MTPS", 4);
+    storeLe32(header + 4, kScheduleFormatVersion);
+    storeLe32(header + 8, static_cast<std::uint32_t>(schedule.num_processors));
+    storeLe32(header + 12, static_cast<std::uint32_t>(schedule.num_buses));
+    storeLe64(header + 16, schedule.entries.size());
+    out.write(header, sizeof(header));
+
+    char record[20] = {0};
+    for (const auto& entry : schedule.entries) {
+        record[0] = static_cast<char>(entry.kind);
+        storeLe32(record + 4, static_cast<std::uint32_t>(entry.resource));
+        storeLe32(record + 8, static_cast<std::uint32_t>(entry.id));
+        storeLe32(record + 12, floatBits(entry.start));
+        storeLe32(record + 16, floatBits(entry.finish));
+        out.write(record, sizeof(record));
+    }
+    out.close();
+}
+
+inline ScheduleResult readBinarySchedule(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("cannot open " + path);
+    std::vector<char> data;
+    char chunk[1 << 16];
+    ssize_t got;
+    while ((got = ::read(fd, chunk, sizeof(chunk))) > 0)
+        data.insert(data.end(), chunk, chunk + got);
+    ::close(fd);
+
+    if (data.size() < 24 || std::memcmp(data.data(), "MTPS", 4) != 0)
+        throw std::runtime_error("not a schedule table: " + path);
+    const std::uint32_t version = loadLe32(data.data() + 4);
+    const std::uint64_t count = loadLe64(data.data() + 16);
+    if (version != kScheduleFormatVersion || count > (data.size() - 24) / 20)
+        throw std::runtime_error("unsupported or truncated schedule table: " + path);
+
+    ScheduleResult schedule;
+    schedule.num_processors = static_cast<int>(loadLe32(data.data() + 8));
+    schedule.num_buses = static_cast<int>(loadLe32(data.data() + 12));
+    schedule.entries.resize(count);
+    const char* record = data.data() + 24;
+    for (auto& entry : schedule.entries) {
+        entry.kind = static_cast<std::uint8_t>(record[0]);
+        entry.resource = static_cast<std::int32_t>(loadLe32(record + 4));
+        entry.id = static_cast<std::int32_t>(loadLe32(record + 8));
+        entry.start = bitsFloat(loadLe32(record + 12));
+        entry.finish = bitsFloat(loadLe32(record + 16));
+        record += 20;
+    }
+    return schedule;
+}
+
+inline bool finiteEntry(const ScheduleEntry& entry) {
+    return std::isfinite(entry.start) && std::isfinite(entry.finish);
+}
+
+// Resource index within the schedule's processors or buses
+inline bool knownResource(const ScheduleResult& schedule, const ScheduleEntry& entry) {
+    const int count = entry.kind == ScheduleEntry::TaskJob ? schedule.num_processors : schedule.num_buses;
+    return entry.resource >= 0 && entry.resource < count;
+}
+
+// Chrome trace-event JSON in microseconds, time_scale per schedule time unit;
+// processors are pid 1 and buses pid 2, one named thread per resource.
+// Entries on a resource outside the schedule's counts are skipped.
+inline void writeChromeTrace(const ScheduleResult& schedule, const std::string& path, double time_scale = 1000) {
+    BufferedWriter out(path);
+    out.put("{\"traceEvents\":[\n");
+    out.put("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Processors\"}},\n");
+    out.put("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"args\":{\"name\":\"Buses\"}}");
+    for (int p = 0; p < schedule.num_processors; ++p) {
+        out.put(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+        out.putInt(p);
+        out.put(",\"args\":{\"name\":\"Processor ");
+        out.putInt(p + 1);
+        out.put("\"}}");
+    }
+    for (int b = 0; b < schedule.num_buses; ++b) {
+        out.put(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":2,\"tid\":");
+        out.putInt(b);
+        out.put(",\"args\":{\"name\":\"Bus ");
+        out.putInt(b + 1);
+        out.put("\"}}");
+    }
+    for (const auto& entry : schedule.entries) {
+        if (!finiteEntry(entry) || !knownResource(schedule, entry))
+            continue;
+        bool task = entry.kind == ScheduleEntry::TaskJob;
+        out.put(task ? ",\n{\"name\":\"Task " : ",\n{\"name\":\"Message ");
+        out.putInt(entry.id);
+        out.put(task ? "\",\"cat\":\"task\",\"ph\":\"X\",\"pid\":1,\"tid\":" : "\",\"cat\":\"message\",\"ph\":\"X\",\"pid\":2,\"tid\":");
+        out.putInt(entry.resource);
+        out.put(",\"ts\":");
+        out.putFixed(entry.start * time_scale);
+        out.put(",\"dur\":");
+        out.putFixed((entry.finish - entry.start) * time_scale);
+        out.put('}');
+    }
+    out.put("\n]}\n");
+    out.close();
+}
+
+// VCD with a 32-bit signal per processor and bus, in microseconds with
+// time_scale per schedule time unit. Entries overlapping on one resource go
+// to extra lanes of it (processor_1_lane2, ...), so every signal only ever
+// holds one entry at a time.
+inline void writeVcd(const ScheduleResult& schedule, const std::string& path, double time_scale = 1000) {
+    const int resources = schedule.num_processors + schedule.num_buses;
+    auto identifier = [](int index) {
+        std::string code;
+        do {
+            code += static_cast<char>('!' + index % 94);
+            index /= 94;
+        } while (index > 0);
+        return code;
+    };
+
+    // Entries in ticks per resource, zero-length and unscheduled ones dropped
+    struct Interval {
+        long long start;
+        long long finish;
+        std::int32_t id;
+    };
+    std::vector<std::vector<Interval>> intervals(resources);
+    for (const auto& entry : schedule.entries) {
+        int resource = entry.kind == ScheduleEntry::TaskJob ? entry.resource : schedule.num_processors + entry.resource;
+        if (resource < 0 || resource >= resources || !finiteEntry(entry))
+            continue;
+        long long start = std::llround(entry.start * time_scale);
+        long long finish = std::llround(entry.finish * time_scale);
+        if (start < 0 || finish <= start)
+            continue;
+        intervals[resource].push_back({start, finish, entry.id});
+    }
+
+    // Greedy interval partitioning into lanes; lane 0 keeps the resource's name
+    struct Lane {
+        int resource;
+        int index;
+    };
+    std::vector<Lane> lanes;
+    struct Change {
+        long long time;
+        int signal;
+        std::int32_t value;
+    };
+    std::vector<Change> changes;
+    changes.reserve(schedule.entries.size() * 2);
+    for (int r = 0; r < resources; ++r) {
+        std::vector<Interval>& list = intervals[r];
+        std::sort(list.begin(), list.end(), [](const Interval& a, const Interval& b) { return a.start < b.start; });
+        std::vector<long long> lane_free; // Finish of the last interval in each lane of this resource
+        const int first = static_cast<int>(lanes.size());
+        lanes.push_back({r, 0});
+        lane_free.push_back(0);
+        for (const Interval& interval : list) {
+            int lane = 0;
+            while (lane < static_cast<int>(lane_free.size()) && lane_free[lane] > interval.start)
+                ++lane;
+            if (lane == static_cast<int>(lane_free.size())) {
+                lanes.push_back({r, lane});
+                lane_free.push_back(0);
+            }
+            lane_free[lane] = interval.finish;
+            changes.push_back({interval.start, first + lane, interval.id});
+            changes.push_back({interval.finish, first + lane, 0});
+        }
+    }
+    // Within a lane intervals never overlap, so idle before busy at equal times
+    std::sort(changes.begin(), changes.end(), [](const Change& a, const Change& b) {
+        if (a.time != b.time)
+            return a.time < b.time;
+        return (a.value != 0) < (b.value != 0);
+    });
+
+    const int signals = static_cast<int>(lanes.size());
+    std::vector<std::string> codes(signals);
+    for (int i = 0; i < signals; ++i)
+        codes[i] = identifier(i);
+
+    BufferedWriter out(path);
+    out.put("$timescale 1 us $end\n$scope module schedule $end\n");
+    for (int i = 0; i < signals; ++i) {
+        bool processor = lanes[i].resource < schedule.num_processors;
+        out.put("$var integer 32 ");
+        out.put(codes[i]);
+        out.put(processor ? " processor_" : " bus_");
+        out.putInt(processor ? lanes[i].resource + 1 : lanes[i].resource - schedule.num_processors + 1);
+        if (lanes[i].index > 0) {
+            out.put("_lane");
+            out.putInt(lanes[i].index + 1);
+        }
+        out.put(" $end\n");
+    }
+    out.put("$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n");
+    for (int i = 0; i < signals; ++i) {
+        out.put("b0 ");
+        out.put(codes[i]);
+        out.put('\n');
+    }
+    out.put("$end\n");
+
+    long long now = 0;
+    for (const auto& change : changes) {
+        if (change.time != now) {
+            now = change.time;
+            out.put('#');
+            out.putInt(now);
+            out.put('\n');
+        }
+        out.put('b');
+        std::uint32_t v = static_cast<std::uint32_t>(change.value);
+        if (v == 0) {
+            out.put('0');
+        } else {
+            char bits[32];
+            int length = 0;
+            while (v) {
+                bits[31 - length++] = static_cast<char>('0' + (v & 1));
+                v >>= 1;
+            }
+            out.write(bits + 32 - length, length);
+        }
+        out.put(' ');
+        out.put(codes[change.signal]);
+        out.put('\n');
+    }
+    out.close();
+}
+
+#endif // SCHEDULE_EXPORT_H
@@ -0,0 +1,451 @@
+#ifndef SCHEDULING_ENGINE_H
+#define SCHEDULING_ENGINE_H
+
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+// Policy-templated engine shared by the Message_scheduling_* programs.
+//
+// The rank, processor selection, bus selection and message EST rules are
+// compile-time policies, so each program is just an instantiation of
+// SchedulingEngine and the inner loops carry no virtual dispatch.
+
+// Define a structure for periodic tasks
+struct PeriodicTask {
+    int id;
+    float period;
+    float deadline;
+    std::vector<float> processing_time; // Processing time on each processor
+    float next_release; // Next release time
+    float rank; // Rank of the task
+    float est; // Earliest Start Time
+    float eft; // Earliest Finish Time
+    int processor; // Processor the task was scheduled on
+};
+
+// Define a structure for messages
+struct Message {
+    int id;
+    int source; // Source stage of the message
+    int destination; // Destination stage of the message
+    float transmission_time; // Time taken to transmit the message
+    float est; // Earliest Start Time
+    float eft; // Earliest Finish Time
+    int bus; // Bus the message was scheduled on
+};
+
+// Define a structure for buses with heterogeneous communication times
+struct Bus {
+    int id;
+    float communication_time; // Communication time of the bus
+    std::vector<float> costs; // Communication costs to each stage
+};
+
+// Time a scheduled message occupies its bus, its own transmission time if unscheduled
+inline float messageCost(const Message& message) {
+    return message.eft > message.est ? message.eft - message.est : message.transmission_time;
+}
+
+// ---------------------------------------------------------------------------
+// Rank policies: static float rank(const PeriodicTask&)
+// Tasks are scheduled in increasing order of rank.
+// ---------------------------------------------------------------------------
+
+// Rate monotonic: shorter period means higher priority
+struct PeriodRank {
+    static float rank(const PeriodicTask& task) { return task.period; }
+};
+
+// ---------------------------------------------------------------------------
+// Processor selection policies:
+// static int select(const PeriodicTask&, const std::vector<float>& busy_until)
+// ---------------------------------------------------------------------------
+
+// Earliest available processor, ties broken by lowest index
+struct EarliestAvailableProcessor {
+    static int select(const PeriodicTask&, const std::vector<float>& busy_until) {
+        float min_busy_until = std::numeric_limits<float>::max();
+        int selected = -1;
+        for (int i = 0; i < static_cast<int>(busy_until.size()); ++i) {
+            if (busy_until[i] < min_busy_until) {
+                min_busy_until = busy_until[i];
+                selected = i;
+            }
+        }
+        return selected;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Bus selection policies: constructed once per message batch from the bus
+// list, then BusSlot assign(const Message&, float ready) places each message.
+// Messages are handed over in increasing order of ready time.
+// ---------------------------------------------------------------------------
+
+// Placement of one message on a bus
+struct BusSlot {
+    int bus; // Index into the bus list
+    float start;
+    float finish;
+};
+
+// Message i travels on bus i, wrapping around the available buses
+class MessageIndexedBus {
+public:
+    explicit MessageIndexedBus(const std::vector<Bus>& buses) : num_buses_(static_cast<int>(buses.size())) {
+        if (buses.empty())
+            throw std::invalid_argument("MessageIndexedBus needs at least one bus");
+    }
+    BusSlot assign(const Message& message, float ready) const {
+        // IDs start at 1; smaller IDs wrap around as well instead of going negative
+        int bus = (message.id - 1) % num_buses_;
+        if (bus < 0)
+            bus += num_buses_;
+        return {bus, ready, ready + message.transmission_time};
+    }
+
+private:
+    int num_buses_;
+};
+
+// Contention-aware placement: every bus keeps a reservation timeline and a
+// message goes to the bus on which it finishes earliest. Transmitting on a bus
+// takes the message's transmission time plus the bus's communication time.
+//
+// Buses with the same communication time are interchangeable, so each such
+// cost class keeps a min-heap of bus availability and only its head can be the
+// best choice. The classes are indexed in turn: a class whose head is free at
+// the ready time finishes at ready + its communication time, so among free
+// classes the cheapest wins; a busy class finishes at head + communication
+// time. Free classes sit in a heap by communication time, busy ones in a heap
+// by head finish and one by head availability that moves them to the free
+// heap once messages become ready after it. While ready times do not
+// decrease, a free class stays free until its head changes; scheduleMessages()
+// places messages in that order. A message ready earlier than the previous one
+// rebuilds the index for its ready time in O(C log C). Stale heap entries are
+// skipped by stamp. Placing a message costs O(log C + log B) for C distinct
+// communication times and B buses.
+class EarliestFinishBus {
+public:
+    struct Reservation {
+        int message; // Message ID
+        float start;
+        float finish;
+    };
+
+    explicit EarliestFinishBus(const std::vector<Bus>& buses) : timelines_(buses.size()), last_ready_(0) {
+        if (buses.empty())
+            throw std::invalid_argument("EarliestFinishBus needs at least one bus");
+        std::vector<int> order(buses.size());
+        for (int i = 0; i < static_cast<int>(buses.size()); ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return buses[a].communication_time < buses[b].communication_time;
+        });
+        for (int i : order) {
+            if (classes_.empty() || classes_.back().communication_time != buses[i].communication_time)
+                classes_.push_back({buses[i].communication_time, {}, 0});
+            classes_.back().available.push_back({0, i});
+        }
+        // Every bus starts free at time 0, so each class is already a valid heap
+        // and is free for any ready time
+        for (int c = 0; c < static_cast<int>(classes_.size()); ++c)
+            pushIndex(free_, {classes_[c].communication_time, c, 0});
+    }
+
+    BusSlot assign(const Message& message, float ready) {
+        if (ready < last_ready_)
+            reindex(ready);
+        last_ready_ = ready;
+
+        // Classes whose head is free by now
+        while (!busy_by_availability_.empty()) {
+            const IndexEntry top = busy_by_availability_.front();
+            if (stale(top)) {
+                popIndex(busy_by_availability_);
+            } else if (top.key <= ready) {
+                popIndex(busy_by_availability_);
+                pushIndex(free_, {classes_[top.cost_class].communication_time, top.cost_class, top.stamp});
+            } else {
+                break;
+            }
+        }
+        while (!free_.empty() && stale(free_.front()))
+            popIndex(free_);
+        while (!busy_by_finish_.empty() && (stale(busy_by_finish_.front()) || headTime(busy_by_finish_.front().cost_class) <= ready))
+            popIndex(busy_by_finish_);
+
+        int best = -1;
+        float best_start = 0;
+        float best_finish = std::numeric_limits<float>::max();
+        auto consider = [&](int c) {
+            float start = std::max(ready, headTime(c));
+            float finish = start + message.transmission_time + classes_[c].communication_time;
+            if (finish < best_finish || (finish == best_finish && c < best)) {
+                best = c;
+                best_start = start;
+                best_finish = finish;
+            }
+        };
+        if (!free_.empty())
+            consider(free_.front().cost_class);
+        if (!busy_by_finish_.empty())
+            consider(busy_by_finish_.front().cost_class);
+
+        CostClass& cost_class = classes_[best];
+        std::vector<Availability>& heap = cost_class.available;
+        std::pop_heap(heap.begin(), heap.end(), Later());
+        int bus = heap.back().bus;
+        heap.back().time = best_finish;
+        std::push_heap(heap.begin(), heap.end(), Later());
+
+        // Re-index the class under its new head
+        const unsigned stamp = ++cost_class.stamp;
+        const float head = heap.front().time;
+        if (head <= ready) {
+            pushIndex(free_, {cost_class.communication_time, best, stamp});
+        } else {
+            pushIndex(busy_by_availability_, {head, best, stamp});
+            pushIndex(busy_by_finish_, {head + cost_class.communication_time, best, stamp});
+        }
+
+        timelines_[bus].push_back({message.id, best_start, best_finish});
+        return {bus, best_start, best_finish};
+    }
+
+    // Reservations made on a bus, in increasing start time
+    const std::vector<Reservation>& timeline(int bus) const { return timelines_[bus]; }
+
+private:
+    struct Availability {
+        float time; // Time from which the bus is free
+        int bus;
+    };
+    // Heap order: earliest availability on top, lower bus index on ties
+    struct Later {
+        bool operator()(const Availability& a, const Availability& b) const {
+            return a.time > b.time || (a.time == b.time && a.bus > b.bus);
+        }
+    };
+    struct CostClass {
+        float communication_time;
+        std::vector<Availability> available;
+        unsigned stamp; // Bumped whenever the head changes
+    };
+    struct IndexEntry {
+        float key;
+        int cost_class;
+        unsigned stamp;
+    };
+    // Smallest key on top, cheaper class on ties
+    struct Greater {
+        bool operator()(const IndexEntry& a, const IndexEntry& b) const {
+            return a.key > b.key || (a.key == b.key && a.cost_class > b.cost_class);
+        }
+    };
+
+    // Index every class afresh as free or busy at `ready`
+    void reindex(float ready) {
+        free_.clear();
+        busy_by_availability_.clear();
+        busy_by_finish_.clear();
+        for (int c = 0; c < static_cast<int>(classes_.size()); ++c) {
+            CostClass& cost_class = classes_[c];
+            const unsigned stamp = ++cost_class.stamp;
+            const float head = headTime(c);
+            if (head <= ready) {
+                pushIndex(free_, {cost_class.communication_time, c, stamp});
+            } else {
+                pushIndex(busy_by_availability_, {head, c, stamp});
+                pushIndex(busy_by_finish_, {head + cost_class.communication_time, c, stamp});
+            }
+        }
+    }
+
+    float headTime(int c) const { return classes_[c].available.front().time; }
+    bool stale(const IndexEntry& entry) const { return classes_[entry.cost_class].stamp != entry.stamp; }
+    static void pushIndex(std::vector<IndexEntry>& heap, const IndexEntry& entry) {
+        heap.push_back(entry);
+        std::push_heap(heap.begin(), heap.end(), Greater());
+    }
+    static void popIndex(std::vector<IndexEntry>& heap) {
+        std::pop_heap(heap.begin(), heap.end(), Greater());
+        heap.pop_back();
+    }
+
+    std::vector<CostClass> classes_;
+    std::vector<IndexEntry> free_; // By communication time
+    std::vector<IndexEntry> busy_by_availability_; // By head availability
+    std::vector<IndexEntry> busy_by_finish_; // By head availability + communication time
+    std::vector<std::vector<Reservation>> timelines_;
+    float last_ready_; // Ready time of the previous message
+};
+
+// ---------------------------------------------------------------------------
+// Message EST policies:
+// static float est(const Message&, const PeriodicTask* source, const PeriodicTask* destination)
+// Either task pointer is null when the stage has no scheduled task.
+// ---------------------------------------------------------------------------
+
+// After both the source and destination tasks have finished
+struct SourceDestinationEftEst {
+    static float est(const Message&, const PeriodicTask* source, const PeriodicTask* destination) {
+        return std::max(source ? source->eft : 0.0f, destination ? destination->eft : 0.0f);
+    }
+};
+
+// After the source task has finished
+struct SourceEftEst {
+    static float est(const Message&, const PeriodicTask* source, const PeriodicTask*) {
+        return source ? source->eft : 0.0f;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Engine
+// ---------------------------------------------------------------------------
+
+template <class RankPolicy, class ProcessorPolicy, class BusPolicy, class MessageEstPolicy>
+struct SchedulingEngine {
+    // Schedule periodic tasks in rank order, one job per task
+    static void schedulePeriodicTasks(std::vector<PeriodicTask>& tasks, int num_processors, bool verbose = true) {
+        using std::cout;
+
+        for (auto& task : tasks)
+            task.rank = RankPolicy::rank(task);
+        std::stable_sort(tasks.begin(), tasks.end(), [](const PeriodicTask& a, const PeriodicTask& b) {
+            return a.rank < b.rank;
+        });
+
+        std::vector<float> processor_busy_until(num_processors, 0); // Track the time until each processor is busy
+
+        if (verbose) {
+            cout << "Nodes: " << tasks.size() << "\tProcessor: " << num_processors << "\n\n";
+
+            cout << "Processing Cost Matrix\n";
+            for (const auto& task : tasks) {
+                cout << "Task " << task.id << ": ";
+                for (float time : task.processing_time)
+                    cout << time << "\t";
+                cout << "\n";
+            }
+
+            cout << "\nAdj Matrix\n";
+            for (const auto& task : tasks) {
+                cout << "Task " << task.id << ": ";
+                for (int i = 0; i < static_cast<int>(tasks.size()); ++i)
+                    cout << (i == task.id - 1 ? "1\t" : "-1\t");
+                cout << "\n";
+            }
+
+            cout << "\nProcessor Matrix\n";
+            for (int i = 0; i < num_processors; ++i) {
+                for (int j = 0; j < num_processors; ++j)
+                    cout << (i == j ? "1\t" : "0\t");
+                cout << "\n";
+            }
+
+            cout << "\nRanks calculated\n";
+            for (const auto& task : tasks)
+                cout << "Task " << task.id << ": " << task.rank << "\n";
+
+            cout << "\nEST and EFT for each task\n";
+            for (const auto& task : tasks) {
+                cout << "Task " << task.id << ":\n";
+                for (int i = 0; i < num_processors; ++i) {
+                    float est = std::max(task.next_release, processor_busy_until[i]);
+                    cout << "Processor " << i << " - EST: " << est << ", EFT: " << est + task.processing_time[i] << "\n";
+                }
+            }
+
+            cout << "\nTask scheduling order\n";
+        }
+
+        for (auto& task : tasks) {
+            int selected_processor = ProcessorPolicy::select(task, processor_busy_until);
+
+            // Schedule the task at or after its next release time
+            float start_time = std::max(task.next_release, processor_busy_until[selected_processor]);
+            float end_time = start_time + task.processing_time[selected_processor];
+
+            task.est = start_time;
+            task.eft = end_time;
+            task.processor = selected_processor;
+            task.next_release += task.period;
+            processor_busy_until[selected_processor] = end_time;
+
+            if (verbose)
+                cout << "Task " << task.id << " scheduled on Processor " << selected_processor + 1 << " from time " << start_time << " to " << end_time << "\n";
+        }
+        if (verbose)
+            cout << std::flush;
+    }
+
+    // Schedule messages on the buses, using the task EFTs for message EST.
+    // Returns the bus policy so callers can inspect any state it kept.
+    static BusPolicy scheduleMessages(std::vector<Message>& messages, const std::vector<Bus>& buses,
+                                 const std::vector<PeriodicTask>& tasks, bool verbose = true) {
+        using std::cout;
+
+        // Stage ID -> task, built once so the message loop is O(1) per lookup
+        int max_id = 0;
+        for (const auto& task : tasks)
+            max_id = std::max(max_id, task.id);
+        std::vector<const PeriodicTask*> by_stage(max_id + 1, nullptr);
+        for (const auto& task : tasks)
+            if (task.id >= 0)
+                by_stage[task.id] = &task;
+        auto lookup = [&](int stage) -> const PeriodicTask* {
+            return (stage >= 0 && stage <= max_id) ? by_stage[stage] : nullptr;
+        };
+
+        // Place messages in order of readiness so bus reservations stay append-only
+        std::vector<float> ready(messages.size());
+        std::vector<int> order(messages.size());
+        for (int i = 0; i < static_cast<int>(messages.size()); ++i) {
+            ready[i] = MessageEstPolicy::est(messages[i], lookup(messages[i].source), lookup(messages[i].destination));
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return ready[a] < ready[b]; });
+
+        BusPolicy bus_policy(buses);
+        for (int i : order) {
+            BusSlot slot = bus_policy.assign(messages[i], ready[i]);
+            messages[i].bus = slot.bus;
+            messages[i].est = slot.start;
+            messages[i].eft = slot.finish;
+        }
+
+        if (!verbose)
+            return bus_policy;
+
+        cout << "\nCommunication Cost Matrix\n";
+        for (const auto& bus : buses) {
+            cout << "Bus " << bus.id << ": ";
+            if (bus.costs.empty()) {
+                cout << bus.communication_time << "\t";
+            } else {
+                for (float cost : bus.costs)
+                    cout << cost << "\t";
+            }
+            cout << "\n";
+        }
+
+        cout << "\nEST and EFT for each message\n";
+        for (const auto& message : messages)
+            cout << "Message " << message.id << " - EST: " << message.est << ", EFT: " << message.eft << "\n";
+
+        cout << "\nMessage scheduling order\n";
+        for (int i : order) {
+            const Message& message = messages[i];
+            cout << "Message " << message.id << " scheduled from Stage " << message.source << " to Stage " << message.destination << " on Bus " << buses[message.bus].id << " from time " << message.est << " to " << message.eft << "\n";
+        }
+        cout << std::flush;
+        return bus_policy;
+    }
+};
+
+#endif // SCHEDULING_ENGINE_H
@@ -0,0 +1,258 @@
+#ifndef SENSITIVITY_ANALYSIS_H
+#define SENSITIVITY_ANALYSIS_H
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "Scheduling_engine.h"
+#include "Schedulability_analysis.h"
+#include "Message_framing.h"
+
+// WCET and signal-size sensitivity: how far execution times or signal sizes
+// can grow before a deadline is missed or the framing no longer fits.
+//
+// Every margin is found by binary search on a scaling factor. Task probes
+// reuse the response-time analysis incrementally: tasks of higher priority
+// than the scaled one keep their response times, and the lower priority ones
+// are warm-started from the last feasible probe, whose response times are
+// lower bounds for any larger factor. The independent searches are spread
+// over threads.
+
+// Largest factor by which one task's execution time (or every task's, for the
+// global entry) can be scaled while its processor stays schedulable
+struct TaskSensitivity {
+    int id; // Task ID, -1 for the global factor
+    int processor;
+    double factor;
+};
+
+struct SignalSensitivity {
+    int id; // Signal ID, -1 for the global factor
+    double factor; // Largest size scaling for which every signal still fits the slot
+    int max_size; // Size at that factor
+};
+
+// Run body(i) for i in [0, count) on up to `threads` threads
+template <class Body>
+void parallelFor(int count, unsigned threads, Body body) {
+    if (threads <= 1 || count <= 1) {
+        for (int i = 0; i < count; ++i)
+            body(i);
+        return;
+    }
+    std::atomic<int> next(0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < std::min<unsigned>(threads, count); ++t)
+        workers.emplace_back([&]() {
+            for (int i = next++; i < count; i = next++)
+                body(i);
+        });
+    for (auto& worker : workers)
+        worker.join();
+}
+
+// Binary search for the largest factor in [low, high] accepted by feasible(),
+// assuming feasibility is monotone; low is returned if nothing is accepted
+template <class Feasible>
+double searchFactor(double low, double high, double tolerance, Feasible feasible) {
+    if (!feasible(low))
+        return low;
+    if (feasible(high))
+        return high;
+    while (high - low > tolerance * std::max(1.0, low)) {
+        double mid = 0.5 * (low + high);
+        if (feasible(mid))
+            low = mid;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+// Largest factor for task `index` of one processor (priority order), or for
+// every task when index is -1
+inline double processorSensitivity(const std::vector<TaskTiming>& base, int index, double tolerance) {
+    if (base.empty())
+        return std::numeric_limits<double>::infinity();
+
+    std::vector<TaskTiming> tasks = base;
+    const std::size_t first = index < 0 ? 0 : static_cast<std::size_t>(index);
+
+    // Upper limits: the scaled part must fit its deadline and the processor
+    double scaled_utilization = 0;
+    double fixed_utilization = 0;
+    double high = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        bool scaled = index < 0 || static_cast<int>(i) == index;
+        double u = tasks[i].wcet / tasks[i].period;
+        if (scaled) {
+            scaled_utilization += u;
+            if (tasks[i].wcet > 0)
+                high = std::min(high, tasks[i].deadline / tasks[i].wcet);
+        } else {
+            fixed_utilization += u;
+        }
+    }
+    if (scaled_utilization > 0)
+        high = std::min(high, (1.0 - fixed_utilization) / scaled_utilization);
+    if (!(high > 0) || std::isinf(high))
+        return std::isinf(high) ? high : 0.0;
+
+    // Response times of the unscaled prefix never change
+    std::vector<double> feasible_response(tasks.size(), 0);
+    std::vector<double> base_response;
+    responseTimeAnalysis(base, &base_response);
+    for (std::size_t i = 0; i < first; ++i)
+        feasible_response[i] = base_response[i];
+
+    // Binary search only ever probes above the last feasible factor, so the
+    // response times kept from that probe stay valid lower bounds
+    std::vector<double> probe;
+    auto feasible = [&](double factor) {
+        for (std::size_t i = first; i < tasks.size(); ++i)
+            tasks[i].wcet = (index < 0 || static_cast<int>(i) == index) ? base[i].wcet * factor : base[i].wcet;
+        probe = feasible_response;
+        if (!incrementalResponseTimeAnalysis(tasks, first, probe))
+            return false;
+        feasible_response.swap(probe);
+        return true;
+    };
+    return searchFactor(0.0, high, tolerance, feasible);
+}
+
+// Per-task and global WCET scaling margins of a partitioned task set. Tasks
+// must carry the processor and rank set by
+// SchedulingEngine::schedulePeriodicTasks(); the global entry comes last.
+inline std::vector<TaskSensitivity> taskSensitivity(const std::vector<PeriodicTask>& tasks, int num_processors,
+                                                    unsigned threads = std::thread::hardware_concurrency(),
+                                                    double tolerance = 1e-4) {
+    std::vector<std::vector<TaskTiming>> partitions = partitionByProcessor(tasks, num_processors);
+
+    // Work items: every task, then every processor for the global factor
+    std::vector<std::pair<int, int>> items; // (processor, index or -1)
+    for (int p = 0; p < num_processors; ++p)
+        for (int i = 0; i < static_cast<int>(partitions[p].size()); ++i)
+            items.push_back({p, i});
+    for (int p = 0; p < num_processors; ++p)
+        items.push_back({p, -1});
+
+    std::vector<double> factors(items.size());
+    parallelFor(static_cast<int>(items.size()), threads, [&](int k) {
+        factors[k] = processorSensitivity(partitions[items[k].first], items[k].second, tolerance);
+    });
+
+    std::vector<TaskSensitivity> result;
+    double global = std::numeric_limits<double>::infinity();
+    for (std::size_t k = 0; k < items.size(); ++k) {
+        int p = items[k].first;
+        if (items[k].second >= 0)
+            result.push_back({partitions[p][items[k].second].id, p, factors[k]});
+        else
+            global = std::min(global, factors[k]);
+    }
+    result.push_back({-1, -1, global});
+    return result;
+}
+
+// Every signal fits the slot chosen by the framing for these sizes
+inline bool framingFits(const std::vector<Signal>& signals, int Tc) {
+    int max_sl_s = maxAggregateSlotSize(signals, Tc);
+    int slot = findOptimalSlotSize(signals, Tc, max_sl_s);
+    if (slot <= 0)
+        return false;
+    for (const Signal& signal : signals)
+        if (signal.size > slot)
+            return false;
+    return true;
+}
+
+// Per-signal and global size scaling margins of a framing over cycle length
+// Tc; the global entry comes last
+inline std::vector<SignalSensitivity> signalSensitivity(const std::vector<Signal>& signals, int Tc,
+                                                        unsigned threads = std::thread::hardware_concurrency()) {
+    const int n = static_cast<int>(signals.size());
+    std::vector<SignalSensitivity> result(n + 1);
+
+    parallelFor(n + 1, threads, [&](int k) {
+        std::vector<Signal> scaled = signals;
+        if (k < n) {
+            // Integer sizes: search the largest size this signal can take
+            int low = signals[k].size;
+            int high = std::max(Tc, low);
+            auto fits = [&](int size) {
+                scaled[k].size = size;
+                return framingFits(scaled, Tc);
+            };
+            int best = 0;
+            if (fits(low)) {
+                best = low;
+                if (fits(high)) {
+                    best = high;
+                } else {
+                    while (high - low > 1) {
+                        int mid = low + (high - low) / 2;
+                        if (fits(mid))
+                            low = mid;
+                        else
+                            high = mid;
+                    }
+                    best = low;
+                }
+            }
+            result[k] = {signals[k].id, signals[k].size > 0 ? static_cast<double>(best) / signals[k].size : 0.0, best};
+        } else {
+            int min_size = Tc;
+            for (const Signal& signal : signals)
+                min_size = std::max(1, std::min(min_size, signal.size));
+            // Scaled sizes are rounded up, so a factor counts only if every byte fits
+            double factor = searchFactor(0.0, static_cast<double>(Tc) / min_size, 1e-3, [&](double f) {
+                for (int i = 0; i < n; ++i)
+                    scaled[i].size = std::max(1, static_cast<int>(std::ceil(signals[i].size * f - 1e-9)));
+                return framingFits(scaled, Tc);
+            });
+            // Fits depend only on the rounded sizes: report the largest factor
+            // that still rounds to the sizes found
+            int max_size = 0;
+            double snapped = std::numeric_limits<double>::infinity();
+            for (const Signal& signal : signals) {
+                int size = std::max(1, static_cast<int>(std::ceil(signal.size * factor - 1e-9)));
+                max_size = std::max(max_size, size);
+                if (signal.size > 0)
+                    snapped = std::min(snapped, static_cast<double>(size) / signal.size);
+            }
+            result[k] = {-1, factor > 0 && !std::isinf(snapped) ? std::max(factor, snapped) : factor, max_size};
+        }
+    });
+    return result;
+}
+
+inline void displayTaskSensitivity(const std::vector<TaskSensitivity>& sensitivity) {
+    using std::cout;
+    cout << "\nWCET sensitivity (largest execution time scaling that keeps deadlines)\n";
+    for (const auto& entry : sensitivity) {
+        if (entry.id < 0)
+            cout << "All tasks - Factor: " << entry.factor << "\n";
+        else
+            cout << "Task " << entry.id << " on Processor " << entry.processor + 1 << " - Factor: " << entry.factor << "\n";
+    }
+    cout << std::flush;
+}
+
+inline void displaySignalSensitivity(const std::vector<SignalSensitivity>& sensitivity) {
+    using std::cout;
+    cout << "\nSignal size sensitivity (largest size scaling that still fits the slot)\n";
+    for (const auto& entry : sensitivity) {
+        if (entry.id < 0)
+            cout << "All signals - Factor: " << entry.factor << ", Largest size: " << entry.max_size << " bytes\n";
+        else
+            cout << "Signal " << entry.id << " - Factor: " << entry.factor << ", Size up to: " << entry.max_size << " bytes\n";
+    }
+    cout << std::flush;
+}
+
+#endif // SENSITIVITY_ANALYSIS_H
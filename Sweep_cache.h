@@ -0,0 +1,245 @@
+#ifndef SWEEP_CACHE_H
+#define SWEEP_CACHE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <future>
+#include <mutex>
+#include <atomic>
+#include <fstream>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+
+// Content-addressed memoization for design-space sweeps.
+//
+// Every pipeline stage (ranks, task schedule, message schedule, framing) is
+// keyed by a hash of exactly the inputs it reads, so sweep points that share a
+// sub-configuration share the stage result. Values are opaque byte strings so
+// the cache can be written to disk and reloaded by a later run. Callers mix a
+// tag identifying the stage code into every key, so a rebuilt pipeline misses
+// instead of reading results of a different one. Every entry also keeps a
+// second, independent hash of the same input; a lookup whose check hash
+// differs is a collision on the 64-bit key and is treated as a miss.
+
+// Version of the cache file layout; files of another version are not loaded
+const std::uint32_t kCacheFormatVersion = 3;
+
+// FNV-1a 64-bit hash over a stream of values, with a multiply-xorshift hash
+// of the same stream as an independent check value
+class ContentHash {
+public:
+    ContentHash() : state_(14695981039346656037ULL), check_(0x9e3779b97f4a7c15ULL) {}
+
+    ContentHash& bytes(const void* data, std::size_t size) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            state_ ^= p[i];
+            state_ *= 1099511628211ULL;
+            check_ = (check_ + p[i] + 1) * 0xff51afd7ed558ccdULL;
+            check_ ^= check_ >> 29;
+        }
+        return *this;
+    }
+    ContentHash& add(std::int64_t value) { return bytes(&value, sizeof(value)); }
+    ContentHash& add(int value) { return add(static_cast<std::int64_t>(value)); }
+    ContentHash& add(std::uint64_t value) { return bytes(&value, sizeof(value)); }
+    ContentHash& add(float value) { return bytes(&value, sizeof(value)); }
+    ContentHash& add(const std::string& text) {
+        add(static_cast<std::int64_t>(text.size()));
+        return bytes(text.data(), text.size());
+    }
+    template <class T>
+    ContentHash& add(const std::vector<T>& values) {
+        add(static_cast<std::int64_t>(values.size()));
+        for (const T& value : values)
+            add(value);
+        return *this;
+    }
+
+    std::uint64_t value() const { return state_; }
+    std::uint64_t check() const {
+        std::uint64_t h = check_ ^ (check_ >> 33);
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        return h ^ (h >> 33);
+    }
+
+private:
+    std::uint64_t state_;
+    std::uint64_t check_;
+};
+
+// Append-only byte encoding for cached values
+class ByteWriter {
+public:
+    template <class T>
+    ByteWriter& put(const T& value) {
+        data_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        return *this;
+    }
+    const std::string& str() const { return data_; }
+
+private:
+    std::string data_;
+};
+
+class ByteReader {
+public:
+    explicit ByteReader(const std::string& data) : data_(data), offset_(0) {}
+    template <class T>
+    T get() {
+        if (data_.size() - offset_ < sizeof(T))
+            throw std::out_of_range("Cached value is truncated");
+        T value;
+        std::memcpy(&value, data_.data() + offset_, sizeof(T));
+        offset_ += sizeof(T);
+        return value;
+    }
+
+private:
+    const std::string& data_;
+    std::size_t offset_;
+};
+
+// Thread-safe memo table. Concurrent requests for the same key compute the
+// value once; the others wait for it.
+class ResultCache {
+public:
+    ResultCache() : hits_(0), misses_(0) {}
+
+    template <class Compute>
+    std::string getOrCompute(const ContentHash& hash, Compute compute) {
+        const std::uint64_t key = hash.value();
+        std::promise<std::string> promise;
+        std::shared_future<std::string> future;
+        bool owner = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(key);
+            if (it != entries_.end() && it->second.check == hash.check()) {
+                future = it->second.value;
+            } else {
+                // New key, or a collision: the latest input takes the slot
+                future = promise.get_future().share();
+                entries_[key] = Entry{hash.check(), future};
+                owner = true;
+            }
+        }
+        if (!owner) {
+            ++hits_;
+            return future.get();
+        }
+        ++misses_;
+        try {
+            promise.set_value(compute());
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(key);
+            if (it != entries_.end() && it->second.check == hash.check())
+                entries_.erase(it);
+        }
+        return future.get();
+    }
+
+    long long hits() const { return hits_; }
+    long long misses() const { return misses_; }
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    // File layout: "MTPC" | u32 version | u64 count | count x { u64 key | u64 check | u64 length | bytes }
+    // Nothing is loaded unless the whole file is well formed.
+    bool load(const std::string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+            return false;
+        std::uint64_t remaining = static_cast<std::uint64_t>(in.tellg());
+        in.seekg(0);
+        char magic[4];
+        std::uint32_t version = 0;
+        std::uint64_t count = 0;
+        const std::uint64_t header = sizeof(magic) + sizeof(version) + sizeof(count);
+        const std::uint64_t entry_header = 3 * sizeof(std::uint64_t);
+        if (remaining < header || !in.read(magic, 4) || std::memcmp(magic, "MTPC", 4) != 0 ||
+            !in.read(reinterpret_cast<char*>(&version), sizeof(version)) || version != kCacheFormatVersion ||
+            !in.read(reinterpret_cast<char*>(&count), sizeof(count)))
+            return false;
+        remaining -= header;
+        if (count > remaining / entry_header)
+            return false;
+
+        struct Loaded {
+            std::uint64_t key;
+            std::uint64_t check;
+            std::string value;
+        };
+        std::vector<Loaded> loaded;
+        loaded.reserve(count);
+        for (std::uint64_t i = 0; i < count; ++i) {
+            std::uint64_t key = 0, check = 0, length = 0;
+            if (remaining < entry_header || !in.read(reinterpret_cast<char*>(&key), sizeof(key)) ||
+                !in.read(reinterpret_cast<char*>(&check), sizeof(check)) ||
+                !in.read(reinterpret_cast<char*>(&length), sizeof(length)))
+                return false;
+            remaining -= entry_header;
+            if (length > remaining)
+                return false;
+            std::string value(length, '\0');
+            if (length > 0 && !in.read(&value[0], static_cast<std::streamsize>(length)))
+                return false;
+            remaining -= length;
+            loaded.push_back({key, check, std::move(value)});
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& entry : loaded) {
+            std::promise<std::string> promise;
+            promise.set_value(std::move(entry.value));
+            entries_.emplace(entry.key, Entry{entry.check, promise.get_future().share()});
+        }
+        return true;
+    }
+
+    // Only finished entries are written
+    bool save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::pair<std::uint64_t, const Entry*>> ready;
+        for (const auto& entry : entries_)
+            if (entry.second.value.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                ready.push_back({entry.first, &entry.second});
+        std::uint64_t count = ready.size();
+        out.write("MTPC", 4);
+        out.write(reinterpret_cast<const char*>(&kCacheFormatVersion), sizeof(kCacheFormatVersion));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        for (const auto& entry : ready) {
+            const std::string& value = entry.second->value.get();
+            std::uint64_t length = value.size();
+            out.write(reinterpret_cast<const char*>(&entry.first), sizeof(entry.first));
+            out.write(reinterpret_cast<const char*>(&entry.second->check), sizeof(entry.second->check));
+            out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            out.write(value.data(), static_cast<std::streamsize>(length));
+        }
+        return static_cast<bool>(out);
+    }
+
+private:
+    struct Entry {
+        std::uint64_t check; // ContentHash::check() of the input
+        std::shared_future<std::string> value;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::uint64_t, Entry> entries_;
+    std::atomic<long long> hits_;
+    std::atomic<long long> misses_;
+};
+
+#endif // SWEEP_CACHE_H
@@ -2,6 +2,10 @@
 #include <vector>
 #include <algorithm>
 #include <limits>
+#include <string>
+#include <cstdlib>
+
+#include "Mapping_optimizer.h"
 
 using namespace std;
 
@@ -23,7 +27,22 @@ void est(int i);
 int Pwik(int p);
 bool sort_R(int i, int j) { return rank_proposed[i] > rank_proposed[j]; }
 
-int main() {
+// Usage: Task_scheduling [--optimize [budget_ms]]
+int main(int argc, char* argv[]) {
+    bool optimize = false;
+    double budget_ms = 50;
+    for (int a = 1; a < argc; ++a) {
+        string arg = argv[a];
+        if (arg == "--optimize") {
+            optimize = true;
+            if (a + 1 < argc && argv[a + 1][0] != '-')
+                budget_ms = atof(argv[++a]);
+        } else {
+            cerr << "Usage: " << argv[0] << " [--optimize [budget_ms]]\n";
+            return 2;
+        }
+    }
+
     cout << "Task Scheduling For Heterogeneous Computing Systems\n";
     cout << "----------------------------------------------------------------\n\n\n";
 
@@ -52,7 +71,7 @@ int main() {
 
     for (int i = nodes - 1; i >= 0; i--) {
         rank_proposed[i] = max_nj_succ(i) + rank_[i];
-        cout << "Node[" << i + 1 << "]\t" << rank_proposed[i] << endl;
+        cout << "Node[" << i + 1 << "]\t" << rank_proposed[i] << "\n";
     }
 
     // Populate ready_list with task IDs and sort based on rank_proposed
@@ -60,14 +79,36 @@ int main() {
         ready_list.push_back(i);
     }
     sort(ready_list.begin(), ready_list.end(), sort_R);
+    vector<int> order(ready_list.rbegin(), ready_list.rend()); // algo() takes tasks from the back
 
     algo();
 
     // Display scheduling order
     cout << "\nTask scheduling order (based on Rank and EFT with heterogeneous processors):\n";
     for (int i = 0; i < nodes; ++i) {
-        cout << "Task " << i + 1 << " with EFT " << aft[i] << " on Processor " << processor_assigned[i]+1 << endl;
+        cout << "Task " << i + 1 << " with EFT " << aft[i] << " on Processor " << processor_assigned[i]+1 << "\n";
+    }
+
+    if (!optimize)
+        return 0;
+
+    // Improve the mapping, seeded from the list schedule
+    MappingProblem problem{nodes, n_proc, {}, {}, vector<vector<pair<int, float>>>(nodes), order};
+    for (int i = 0; i < nodes; i++)
+        for (int j = 0; j < n_proc; j++)
+            problem.weight.push_back(weight[i][j]);
+    for (int i = 0; i < n_proc; i++)
+        for (int j = 0; j < n_proc; j++)
+            problem.link.push_back(p_matrix[i][j]);
+    for (int i = 0; i < nodes; i++)
+        for (int j = 0; j < nodes; j++)
+            if (i != j && adj[i][j] != -1)
+                problem.predecessors[j].push_back({i, static_cast<float>(adj[i][j])});
+    if (!sortPredecessorsFirst(problem)) {
+        cerr << "Task graph has a cycle; mapping not optimized\n";
+        return 1;
     }
+    displayMapping(problem, optimizeMapping(problem, vector<int>(processor_assigned, processor_assigned + nodes), budget_ms));
 
     return 0;
 }
@@ -76,13 +117,13 @@ void algo() {
     while (!ready_list.empty()) {
         int task_id = ready_list.back();
         ready_list.pop_back();
-        cout << "\tPROCESS " << task_id + 1 << endl;
+        cout << "\tPROCESS " << task_id + 1 << "\n";
         float min = numeric_limits<float>::max();
         est(task_id);
         cout << "\nEST\t";
         for (int z = 0; z < n_proc; z++)
             cout << EST[task_id][z] << "\t";
-        cout << endl << "EFT\t";
+        cout << "\nEFT\t";
 
         int pro = -1; // Processor to be assigned
         for (int i = 0; i < n_proc; i++) {
@@ -114,9 +155,9 @@ void algo() {
                 tp[pro] = EFT[task_id][pro];
             }
         }
-        cout << "\nActual Finish Time:\t" << aft[task_id] << endl;
-        cout << "Processor Selected:\t" << processor_assigned[task_id]+1 << endl;
-        cout << "Processor State:\t" << tp[0] << "\t" << tp[1] << endl;
+        cout << "\nActual Finish Time:\t" << aft[task_id] << "\n";
+        cout << "Processor Selected:\t" << processor_assigned[task_id]+1 << "\n";
+        cout << "Processor State:\t" << tp[0] << "\t" << tp[1] << "\n";
         cout << "\n_____________________________________________________________\n\n";
     }
 }
@@ -176,24 +217,24 @@ float weight_ni(int ni) {
 }
 
 void display() {
-    cout << "\nNodes: " << nodes << "\tProcessor: " << n_proc << endl << endl;
+    cout << "\nNodes: " << nodes << "\tProcessor: " << n_proc << "\n\n";
     cout << "Processing Cost Matrix\n";
     for (int i = 0; i < nodes; i++) {
         for (int j = 0; j < n_proc; j++)
             cout << weight[i][j] << "\t";
-        cout << endl;
+        cout << "\n";
     }
-    cout << endl << "Adj Matrix\n";
+    cout << "\nAdj Matrix\n";
     for (int i = 0; i < nodes; i++) {
         for (int j = 0; j < nodes; j++)
             cout << adj[i][j] << " ";
-        cout << endl;
+        cout << "\n";
     }
-    cout << endl << "Processor Matrix\n";
+    cout << "\nProcessor Matrix\n";
     for (int i = 0; i < n_proc; i++) {
         for (int j = 0; j < n_proc; j++)
             cout << p_matrix[i][j] << "\t";
-        cout << endl << endl;
+        cout << "\n\n";
     }
 }
 